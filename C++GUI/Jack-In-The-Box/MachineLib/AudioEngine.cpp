@@ -0,0 +1,229 @@
+/**
+ * @file AudioEngine.cpp
+ * @author Jaylon Sifuentes
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include "AudioEngine.h"
+#include "WavFile.h"
+
+using namespace std::chrono;
+
+/// Longest time the mixer thread sleeps before checking for work
+const milliseconds MixerIdleWait(20);
+
+/// Delay added to every sound so ones timed slightly in the past still play whole
+const double ScheduleLatency = 0.05;
+
+/**
+ * Get the engine shared by every music box.
+ *
+ * The engine is created when first needed and destroyed
+ * when the last music box using it goes away.
+ *
+ * @return The shared audio engine
+ */
+std::shared_ptr<AudioEngine> AudioEngine::GetShared()
+{
+    static std::mutex mutex;
+    static std::weak_ptr<AudioEngine> shared;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto engine = shared.lock();
+    if (engine == nullptr)
+    {
+        engine = std::make_shared<AudioEngine>();
+        shared = engine;
+    }
+
+    return engine;
+}
+
+/**
+ * Destructor. Stops the mixer thread.
+ */
+AudioEngine::~AudioEngine()
+{
+    if (mThread.joinable())
+    {
+        mRunning = false;
+        mWake.notify_one();
+        mThread.join();
+    }
+}
+
+/**
+ * Load and decode a sound file.
+ *
+ * Files that have already been loaded are not decoded again.
+ * Safe to call from any thread, even while sounds are playing.
+ *
+ * @param filename WAV file to load
+ * @return Id of the sound or -1 if the file could not be decoded
+ */
+int AudioEngine::LoadSound(const std::wstring &filename)
+{
+    std::lock_guard<std::mutex> lock(mSoundsMutex);
+    auto found = mSoundFiles.find(filename);
+    if (found != mSoundFiles.end())
+    {
+        return found->second;
+    }
+
+    std::vector<int16_t> samples;
+    int id = -1;
+    if (WavFile::Read(filename, samples))
+    {
+        id = (int)mSounds.size();
+        mSounds.push_back(std::make_unique<const std::vector<int16_t>>(std::move(samples)));
+        mSoundCount = (int)mSounds.size();
+    }
+
+    mSoundFiles[filename] = id;
+    return id;
+}
+
+/**
+ * Start playing a sound.
+ *
+ * The offset places the sound in time relative to the call, so
+ * a sound that should have started between two frames keeps its
+ * timing. Every sound is delayed by ScheduleLatency so offsets of
+ * up to that much in the past are played in full.
+ *
+ * Never blocks. The sound is dropped if the mixer has
+ * fallen too far behind to accept it. Must always be called
+ * from the same thread, the one running the simulation.
+ *
+ * @param sound Id of the sound from LoadSound
+ * @param offset Seconds from now the sound should start, usually zero or negative
+ */
+void AudioEngine::Trigger(int sound, double offset)
+{
+    if (sound < 0 || sound >= mSoundCount)
+    {
+        return;
+    }
+
+    if (!mThread.joinable())
+    {
+        mRunning = true;
+        mThread = std::thread(&AudioEngine::Run, this);
+    }
+
+    auto start = steady_clock::now() + duration_cast<steady_clock::duration>(duration<double>(offset + ScheduleLatency));
+    if (mCommands.Push({sound, start}))
+    {
+        mWake.notify_one();
+    }
+}
+
+/**
+ * Get the decoded samples of a sound
+ * @param sound Id of the sound from LoadSound
+ * @return Interleaved stereo samples
+ */
+const std::vector<int16_t> &AudioEngine::GetSamples(int sound) const
+{
+    std::lock_guard<std::mutex> lock(mSoundsMutex);
+    return *mSounds[sound];
+}
+
+/**
+ * The mixer thread
+ */
+void AudioEngine::Run()
+{
+    while (mRunning)
+    {
+        bool started = false;
+        Voice voice;
+        while (mCommands.Pop(voice))
+        {
+            mVoices.push_back(voice);
+            started = true;
+        }
+
+        if (started)
+        {
+            auto wav = Mix(steady_clock::now());
+            if (wxTheApp != nullptr)
+            {
+                // The engine may be gone by the time the main thread gets to the mix
+                std::weak_ptr<AudioEngine> engine = weak_from_this();
+                wxTheApp->CallAfter([engine, wav] {
+                    if (auto playing = engine.lock())
+                    {
+                        playing->Play(wav);
+                    }
+                });
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(mWakeMutex);
+        mWake.wait_for(lock, MixerIdleWait);
+    }
+}
+
+/**
+ * Mix the remainder of every ringing sound.
+ *
+ * Sounds scheduled after now are preceded by silence, so each
+ * starts at its own time within the mix.
+ *
+ * @param now Time the mix starts playing
+ * @return The mix as a WAV file in memory
+ */
+std::vector<uint8_t> AudioEngine::Mix(steady_clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(mSoundsMutex);
+
+    std::vector<int> mix;
+    std::vector<Voice> ringing;
+    for (auto &voice : mVoices)
+    {
+        const auto &samples = *mSounds[voice.mSound];
+        auto played = duration_cast<microseconds>(now - voice.mStart).count();
+        long long frames = played * WavFile::SampleRate / 1000000;
+        size_t skip = frames > 0 ? (size_t)frames * WavFile::Channels : 0;
+        size_t delay = frames < 0 ? (size_t)-frames * WavFile::Channels : 0;
+        if (skip >= samples.size())
+        {
+            continue;
+        }
+
+        ringing.push_back(voice);
+        if (mix.size() < delay + samples.size() - skip)
+        {
+            mix.resize(delay + samples.size() - skip);
+        }
+
+        for (size_t i = skip; i < samples.size(); i++)
+        {
+            mix[delay + i - skip] += samples[i];
+        }
+    }
+
+    mVoices = std::move(ringing);
+
+    std::vector<int16_t> output(mix.size());
+    for (size_t i = 0; i < mix.size(); i++)
+    {
+        output[i] = (int16_t)std::clamp(mix[i], -32768, 32767);
+    }
+
+    return WavFile::Encode(output);
+}
+
+/**
+ * Play a mix in place of the one playing. Called on the main thread.
+ * @param wav The mix as a WAV file in memory
+ */
+void AudioEngine::Play(const std::vector<uint8_t> &wav)
+{
+    if (mOutput.Create(wav.size(), wav.data()))
+    {
+        mOutput.Play(wxSOUND_ASYNC);
+    }
+}
@@ -0,0 +1,108 @@
+/**
+ * @file AudioEngine.h
+ * @author Jaylon Sifuentes
+ *
+ * Mixer that plays pre-decoded sounds on a background thread.
+ */
+
+#ifndef AUDIOENGINE_H
+#define AUDIOENGINE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <wx/sound.h>
+#include "LockFreeQueue.h"
+
+/**
+ * Mixer that plays pre-decoded sounds on a background thread.
+ *
+ * There is one engine shared by every music box, obtained with
+ * GetShared. Sounds are decoded once when loaded. Triggering a sound
+ * only pushes its id onto a lock-free queue, so the simulation never
+ * opens a file or blocks on audio output.
+ *
+ * The mixer thread keeps a list of the sounds still ringing and
+ * mixes them together each time a new one starts, so overlapping
+ * notes sound at the same time rather than cutting each other off.
+ *
+ * wxWidgets has no streaming audio output, so each mix is played
+ * as a wxSound that replaces the one before it. wxSound is not
+ * thread safe, so the mix is handed to the main thread to play.
+ * Without an application object, as in the batch renderer, nothing
+ * is played.
+ */
+class AudioEngine : public std::enable_shared_from_this<AudioEngine>
+{
+private:
+    /// A sound that is playing or scheduled to play
+    struct Voice
+    {
+        /// Id of the sound
+        int mSound;
+        /// Time the sound starts
+        std::chrono::steady_clock::time_point mStart;
+    };
+
+    /// The decoded sounds as interleaved stereo samples, indexed by id
+    std::vector<std::unique_ptr<const std::vector<int16_t>>> mSounds;
+
+    /// Id of each loaded sound file
+    std::map<std::wstring, int> mSoundFiles;
+
+    /// Number of decoded sounds, for Trigger to check ids without locking
+    std::atomic<int> mSoundCount{0};
+
+    /// Protects the sounds, which music boxes on any thread may load
+    mutable std::mutex mSoundsMutex;
+
+    /// Sounds triggered and not yet picked up by the mixer
+    LockFreeQueue<Voice, 256> mCommands;
+
+    /// The mixer thread. Started by the first trigger.
+    std::thread mThread;
+
+    /// True while the mixer thread should keep running
+    std::atomic<bool> mRunning{false};
+
+    /// Mutex the mixer thread waits on
+    std::mutex mWakeMutex;
+
+    /// Signalled when a sound is triggered
+    std::condition_variable mWake;
+
+    /// Sounds still ringing or waiting to start. Only used by the mixer thread.
+    std::vector<Voice> mVoices;
+
+    /// The mix currently playing. Only used on the main thread.
+    wxSound mOutput;
+
+    void Run();
+    std::vector<uint8_t> Mix(std::chrono::steady_clock::time_point now);
+    void Play(const std::vector<uint8_t> &wav);
+
+public:
+    AudioEngine() = default;
+    ~AudioEngine();
+
+    /// Copy constructor (disabled)
+    AudioEngine(const AudioEngine &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const AudioEngine &) = delete;
+
+    static std::shared_ptr<AudioEngine> GetShared();
+
+    int LoadSound(const std::wstring &filename);
+
+    void Trigger(int sound, double offset = 0);
+
+    const std::vector<int16_t> &GetSamples(int sound) const;
+};
+
+
+#endif //AUDIOENGINE_H
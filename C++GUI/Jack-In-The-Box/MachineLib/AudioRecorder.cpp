@@ -0,0 +1,109 @@
+/**
+ * @file AudioRecorder.cpp
+ * @author Jaylon Sifuentes
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include <cmath>
+#include "AudioRecorder.h"
+#include "WavFile.h"
+
+/**
+ * Constructor. Writes a WAV header that is completed by Close.
+ * @param stream Stream to write to
+ * @param startTime Machine time at the start of the recording
+ */
+AudioRecorder::AudioRecorder(std::ostream &stream, double startTime) : mStream(stream), mStartTime(startTime)
+{
+    auto header = WavFile::Header(0);
+    mStream.write((const char *)header.data(), header.size());
+}
+
+/**
+ * Sample frame a machine time falls on
+ * @param time Machine time in seconds
+ * @return Frame number from the start of the recording
+ */
+size_t AudioRecorder::FrameAt(double time) const
+{
+    return (size_t)std::max(0.0, std::round((time - mStartTime) * WavFile::SampleRate));
+}
+
+/**
+ * Mix a sound into the recording.
+ *
+ * Any part of the sound before the samples already
+ * written or the start of the recording is dropped.
+ *
+ * @param samples Interleaved stereo samples of the sound
+ * @param time Machine time the sound starts
+ */
+void AudioRecorder::Record(const std::vector<int16_t> &samples, double time)
+{
+    double offset = std::round((time - mStartTime) * WavFile::SampleRate);
+    size_t skip = offset < mWritten ? (size_t)(mWritten - offset) * WavFile::Channels : 0;
+    size_t start = offset > mWritten ? ((size_t)offset - mWritten) * WavFile::Channels : 0;
+    if (skip >= samples.size())
+    {
+        return;
+    }
+
+    if (mPending.size() < start + samples.size() - skip)
+    {
+        mPending.resize(start + samples.size() - skip);
+    }
+
+    for (size_t i = skip; i < samples.size(); i++)
+    {
+        mPending[start + i - skip] += samples[i];
+    }
+}
+
+/**
+ * Write out the recording up to a machine time.
+ * No sound may be recorded before this time afterwards.
+ * @param time Machine time in seconds
+ */
+void AudioRecorder::Flush(double time)
+{
+    size_t end = FrameAt(time);
+    if (end <= mWritten)
+    {
+        return;
+    }
+
+    size_t count = (end - mWritten) * WavFile::Channels;
+    if (mPending.size() < count)
+    {
+        mPending.resize(count);
+    }
+
+    std::vector<char> data(count * 2);
+    for (size_t i = 0; i < count; i++)
+    {
+        auto sample = (uint16_t)(int16_t)std::clamp(mPending[i], -32768, 32767);
+        data[i * 2] = (char)(sample & 0xff);
+        data[i * 2 + 1] = (char)(sample >> 8);
+    }
+
+    mStream.write(data.data(), data.size());
+    mPending.erase(mPending.begin(), mPending.begin() + count);
+    mWritten = end;
+}
+
+/**
+ * End the recording at a machine time and complete the
+ * WAV header. The stream must be seekable.
+ * @param time Machine time in seconds
+ */
+void AudioRecorder::Close(double time)
+{
+    Flush(time);
+    mPending.clear();
+
+    auto header = WavFile::Header(mWritten * WavFile::Channels * 2);
+    mStream.seekp(0);
+    mStream.write((const char *)header.data(), header.size());
+    mStream.flush();
+}
@@ -0,0 +1,59 @@
+/**
+ * @file AudioRecorder.h
+ * @author Jaylon Sifuentes
+ *
+ * Records the sounds a machine makes to a WAV stream.
+ */
+
+#ifndef AUDIORECORDER_H
+#define AUDIORECORDER_H
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+/**
+ * Records the sounds a machine makes to a WAV stream.
+ *
+ * Sounds are mixed at the machine time they are made rather
+ * than when they are received, so the recording lines up with
+ * the frames and runs as fast as the machine can be advanced.
+ *
+ * Mixed samples are written out as the machine time passes
+ * them, so only the sounds still ringing are kept in memory.
+ */
+class AudioRecorder
+{
+private:
+    /// Stream the WAV file is written to
+    std::ostream &mStream;
+
+    /// Machine time at the start of the recording
+    double mStartTime;
+
+    /// Number of sample frames written to the stream
+    size_t mWritten = 0;
+
+    /// Mixed samples not yet written, starting at frame mWritten
+    std::vector<int> mPending;
+
+    size_t FrameAt(double time) const;
+
+public:
+    AudioRecorder(std::ostream &stream, double startTime);
+
+    /// Copy constructor (disabled)
+    AudioRecorder(const AudioRecorder &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const AudioRecorder &) = delete;
+
+    void Record(const std::vector<int16_t> &samples, double time);
+
+    void Flush(double time);
+
+    void Close(double time);
+};
+
+
+#endif //AUDIORECORDER_H
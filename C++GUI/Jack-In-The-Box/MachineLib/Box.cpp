@@ -5,6 +5,7 @@
 
 #include "pch.h"
 #include "Box.h"
+#include "DisplayList.h"
 
 /// Image path for box background
 std::wstring const BoxBackgroundImage = L"/box-background.png";
@@ -39,12 +40,12 @@ Box::Box(std::wstring imagesDir, int boxSize, int lidSize)
     mBoxFace.SetImage(imagesDir + BoxForegroundImage);
 }
 
-void Box::DrawComponentBackground(std::shared_ptr<wxGraphicsContext> graphics)
+void Box::DrawComponentBackground(DisplayList &list) const
 {
 
-    mBox.DrawPolygon(graphics, GetX(), GetY());
+    list.DrawPolygon(mBox, GetX(), GetY());
     // Amimate box open and close by resizing.
-    graphics->PushState();
+    list.PushState();
     double sine = sin(mLidAngle);
     double lidScale = LidZeroAngleScale + (1.0 - LidZeroAngleScale) * sine;
 
@@ -58,15 +59,15 @@ void Box::DrawComponentBackground(std::shared_ptr<wxGraphicsContext> graphics)
     {
         currPt = closeTrans;
     }
-    graphics->Translate(currPt.x, currPt.y);
-    graphics->Scale(1, lidScale);
-    mLid.DrawPolygon(graphics, 0, 0);
-    graphics->PopState();
+    list.Translate(currPt.x, currPt.y);
+    list.Scale(1, lidScale);
+    list.DrawPolygon(mLid, 0, 0);
+    list.PopState();
 }
 
-void Box::DrawComponentForeground(std::shared_ptr<wxGraphicsContext> graphics)
+void Box::DrawComponentForeground(DisplayList &list) const
 {
-    mBoxFace.DrawPolygon(graphics, GetX(), GetY());
+    list.DrawPolygon(mBoxFace, GetX(), GetY());
 }
 
 /**
@@ -88,14 +89,46 @@ void Box::Advance(double increase)
     }
 }
 
+void Box::Bind(ComponentStore &store)
+{
+    Component::Bind(store);	// Upcall
+    store.AddAnimated(this);
+}
+
 void Box::Reset()
 {
     mLidAngle = 0;
+    mOpen = false;
 }
 
-void Box::OnKeyDrop()
+void Box::OnKeyDrop(double time)
 {
+    if(mOpen)
+    {
+        return;
+    }
+
     mOpen = true;
+    mKeyDropTime = time;
+
+    // If the key dropped in the past (seeking), the lid is already partly open
+    double openAngle = M_PI / 2;
+    double elapsed = GetTime() - mKeyDropTime;
+    mLidAngle = std::min(openAngle, std::max(0.0, openAngle * elapsed / LidOpeningTime));
 }
 
+void Box::SaveState(Checkpoint &checkpoint)
+{
+    Component::SaveState(checkpoint);	// Upcall
+    checkpoint.Write(mLidAngle);
+    checkpoint.Write(mOpen);
+    checkpoint.Write(mKeyDropTime);
+}
 
+void Box::RestoreState(Checkpoint &checkpoint)
+{
+    Component::RestoreState(checkpoint);	// Upcall
+    mLidAngle = checkpoint.Read();
+    mOpen = checkpoint.Read() != 0;
+    mKeyDropTime = checkpoint.Read();
+}
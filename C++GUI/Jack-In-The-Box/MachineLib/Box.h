@@ -30,6 +30,8 @@ private:
     double mLidAngle = 0;
     /// If the lid is open
     bool mOpen = false;
+    /// Time the key dropped and the lid started opening
+    double mKeyDropTime = 0;
 
 public:
     /**
@@ -41,24 +43,43 @@ public:
     Box(std::wstring imagesDir, int boxSize, int lidSize);
     /**
     * Draw the component at the currently specified location in the background.
-    * @param graphics Graphics object to render to
+    * @param list Display list to record the drawing into
     */
-    void DrawComponentBackground(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void DrawComponentBackground(DisplayList &list) const override;
     /**
     * Draw the component at the currently specified location in the foreground.
-    * @param graphics Graphics object to render to
+    * @param list Display list to record the drawing into
     */
-    void DrawComponentForeground(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void DrawComponentForeground(DisplayList &list) const override;
     void Advance(double increase) override;
     /**
      * Reset box attributes
      */
     void Reset() override;
+
+    /**
+     * Add the box to the animated components of the machine's component store
+     * @param store Component store of the machine
+     */
+    void Bind(ComponentStore &store) override;
+
+    /**
+     * Save the simulation state of this component
+     * @param checkpoint Checkpoint to write the state to
+     */
+    void SaveState(Checkpoint &checkpoint) override;
+
+    /**
+     * Restore the simulation state of this component
+     * @param checkpoint Checkpoint to read the state from
+     */
+    void RestoreState(Checkpoint &checkpoint) override;
    /**
    * When called by Cam, this function triggers the
    * box to open.
+   * @param time Machine time in seconds at which the key dropped
    */
-    void OnKeyDrop() override;
+    void OnKeyDrop(double time) override;
 };
 
 
@@ -4,6 +4,7 @@
  */
 #include "pch.h"
 #include "Cam.h"
+#include "DisplayList.h"
 #include "IKeyResponder.h"
 
 /// Width of the cam on the screen in pixels
@@ -26,6 +27,8 @@ const int HoleXOffset = 4;
 const int HoleYOffset = 5;
 /// Hole rotation speed div
 const int HoleRotDiv = 3;
+/// Cam rotation in turns at which the hole reaches the key
+const double KeyDropRotation = HoleRotDiv;
 
 Cam::Cam(std::wstring resourcesDir, wxPoint location)
 {
@@ -38,15 +41,15 @@ Cam::Cam(std::wstring resourcesDir, wxPoint location)
     mKey.Rectangle(-KeyImageSize/2, 0, KeyImageSize, KeyImageSize);
 }
 
-void Cam::DrawComponentBackground(std::shared_ptr<wxGraphicsContext> graphics)
+void Cam::DrawComponentBackground(DisplayList &list) const
 {
 }
 
-void Cam::DrawComponentForeground(std::shared_ptr<wxGraphicsContext> graphics)
+void Cam::DrawComponentForeground(DisplayList &list) const
 {
     // Draw the cam rectangle
-    mCamCylinder.Draw(graphics, GetX(), GetY(), 0);
-    graphics->SetBrush(*wxBLACK_BRUSH);
+    list.DrawCylinder(mCamCylinder, GetX(), GetY(), 0);
+    list.SetBrush(mHoleBrush);
     // Calculate current position
     double startX = GetX() + (CamWidth / HoleXOffset);
     double startY = GetY() + (CamDiameter / 2) - HoleYOffset;
@@ -63,37 +66,74 @@ void Cam::DrawComponentForeground(std::shared_ptr<wxGraphicsContext> graphics)
     // Calculate new scaled height and y position
     double scaledHeight = ScaleMult * verticalScaler;
     double yOffset = (ScaleMult * (verticalScaler - 1.0)) / 2.0;
-    graphics->SetBrush(*wxBLACK_BRUSH);
+    list.SetBrush(mHoleBrush);
     /*
      * Move the hole along the rectangle until it has reached the end point.
-     * Once at the end, trigger key drop event.
+     * Once at the end, the key has dropped into it.
      */
-    if(currentY > endY)
+    if(!mKeyDropped)
     {
-        graphics->DrawEllipse(startX, currentY - yOffset, HoleSize, scaledHeight);
-        mKey.DrawPolygon(graphics, GetX() + HoleXOffset * 2, GetY() - (CamDiameter / 2));
+        list.DrawEllipse(startX, currentY - yOffset, HoleSize, scaledHeight);
+        list.DrawPolygon(mKey, GetX() + HoleXOffset * 2, GetY() - (CamDiameter / 2));
     } else
     {
-        mKey.DrawPolygon(graphics, GetX() + HoleXOffset * 2, GetY() - KeyImageSize);
-        mCamCylinder.Draw(graphics, GetX(), GetY(), 0);
-        HoleUnderKey();
+        list.DrawPolygon(mKey, GetX() + HoleXOffset * 2, GetY() - KeyImageSize);
+        list.DrawCylinder(mCamCylinder, GetX(), GetY(), 0);
     }
 }
 
 void Cam::Reset()
 {
     mRotation = 0;
+    mKeyDropped = false;
+    mLastTime = 0;
 }
 
 void Cam::UpdateRotation(double rotation)
 {
+    double lastRotation = mRotation;
+    double lastTime = mLastTime;
     mRotation = rotation;
+    mLastTime = GetTime();
+
+    /*
+     * Once the hole reaches the end of the cam, trigger the key drop event.
+     * The drive turns at a constant speed between updates, so the time
+     * the hole reached the key is interpolated from the last update. When
+     * seeking the last update is the reset state at time zero.
+     */
+    if(!mKeyDropped && mRotation >= KeyDropRotation)
+    {
+        mKeyDropped = true;
+        double fraction = 1;
+        if(lastRotation < KeyDropRotation)
+        {
+            fraction = (KeyDropRotation - lastRotation) / (mRotation - lastRotation);
+        }
+        HoleUnderKey(lastTime + (mLastTime - lastTime) * fraction);
+    }
 }
 
-void Cam::HoleUnderKey()
+void Cam::HoleUnderKey(double time)
 {
-    for(auto responder : mKeyResponders)
+    for(const auto &responder : mKeyResponders)
     {
-        responder->OnKeyDrop();
+        responder->OnKeyDrop(time);
     }
 }
+
+void Cam::SaveState(Checkpoint &checkpoint)
+{
+    Component::SaveState(checkpoint);	// Upcall
+    checkpoint.Write(mRotation);
+    checkpoint.Write(mKeyDropped);
+    checkpoint.Write(mLastTime);
+}
+
+void Cam::RestoreState(Checkpoint &checkpoint)
+{
+    Component::RestoreState(checkpoint);	// Upcall
+    mRotation = checkpoint.Read();
+    mKeyDropped = checkpoint.Read() != 0;
+    mLastTime = checkpoint.Read();
+}
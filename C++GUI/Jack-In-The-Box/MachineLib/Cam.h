@@ -32,6 +32,15 @@ private:
     /// Key image
     cse335::Polygon mKey;
 
+    /// Brush to draw the hole with. Not the stock black brush, whose
+    /// data would be shared with machines on other threads.
+    wxBrush mHoleBrush = wxBrush(wxColour(0, 0, 0));
+
+    /// Set once the hole has reached the key
+    bool mKeyDropped = false;
+    /// Machine time at the last rotation update
+    double mLastTime = 0;
+
 public:
     /**
      * Cam default constructor
@@ -47,18 +56,30 @@ public:
     Cam& operator=(const Cam&) = delete;
     /**
     * Draw the cam at the currently specified location in the background.
-    * @param graphics Graphics object to render to
+    * @param list Display list to record the drawing into
     */
-    void DrawComponentBackground(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void DrawComponentBackground(DisplayList &list) const override;
     /**
     * Draw the component at the currently specified location in the foreground.
-    * @param graphics Graphics object to render to
+    * @param list Display list to record the drawing into
     */
-    void DrawComponentForeground(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void DrawComponentForeground(DisplayList &list) const override;
     /**
      * Reset this component
      */
     void Reset() override;
+
+    /**
+     * Save the simulation state of this component
+     * @param checkpoint Checkpoint to write the state to
+     */
+    void SaveState(Checkpoint &checkpoint) override;
+
+    /**
+     * Restore the simulation state of this component
+     * @param checkpoint Checkpoint to read the state from
+     */
+    void RestoreState(Checkpoint &checkpoint) override;
     /**
    * Updates the rotation of the cam based on its source.
    * Override from IRotationSink
@@ -78,8 +99,9 @@ public:
     /**
      * Called when the hole is underneath the key.
      * Alerts all key responders of the event!
+     * @param time Machine time in seconds at which the key dropped
      */
-    void HoleUnderKey();
+    void HoleUnderKey(double time);
 };
 
 
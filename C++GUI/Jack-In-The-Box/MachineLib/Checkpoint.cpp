@@ -0,0 +1,7 @@
+/**
+ * @file Checkpoint.cpp
+ * @author Jaylon Sifuentes
+ */
+
+#include "pch.h"
+#include "Checkpoint.h"
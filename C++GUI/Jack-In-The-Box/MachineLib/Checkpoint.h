@@ -0,0 +1,49 @@
+/**
+ * @file Checkpoint.h
+ * @author Jaylon Sifuentes
+ *
+ * Class that represents a snapshot of machine state.
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <vector>
+
+/**
+ * A snapshot of the simulation state of a machine and its components.
+ *
+ * Components write their state in order with Write and read it back
+ * in the same order with Read, so a machine can be put back exactly
+ * as it was at the frame the checkpoint was taken.
+ */
+class Checkpoint
+{
+private:
+    /// The saved state values in the order they were written
+    std::vector<double> mValues;
+
+    /// Position of the next value to read
+    size_t mPosition = 0;
+
+public:
+    /**
+     * Write a value to the checkpoint
+     * @param value Value to save
+     */
+    void Write(double value) { mValues.push_back(value); }
+
+    /**
+     * Read the next value from the checkpoint
+     * @return Next saved value
+     */
+    double Read() { return mValues[mPosition++]; }
+
+    /**
+     * Start reading from the beginning of the checkpoint
+     */
+    void Rewind() { mPosition = 0; }
+};
+
+
+#endif //CHECKPOINT_H
@@ -10,6 +10,11 @@
 // WHY SHAFT NEED THESE HEADERS BUT OTHERS DID NOT
 #include <memory>
 #include <wx/graphics.h>
+#include "Checkpoint.h"
+#include "ComponentStore.h"
+
+class AudioRecorder;
+class DisplayList;
 
 
 /**
@@ -20,21 +25,24 @@ class Component
 private:
     /// Location of component
     wxPoint mLocation = wxPoint(0, 0);
-    /// Time
+    /// Time while the component is not part of a machine
     double mTime = 0;
+    /// Clock the component reads its time from.
+    /// Points to the machine clock once the component is bound.
+    const double *mClock = &mTime;
 
 public:
     /**
    * Draw the component at the currently specified location in the background.
-   * @param graphics Graphics object to render to
+   * @param list Display list to record the drawing into
    */
-    virtual void DrawComponentBackground(std::shared_ptr<wxGraphicsContext> graphics) = 0;
+    virtual void DrawComponentBackground(DisplayList &list) const = 0;
 
     /**
    * Draw the component at the currently specified location in the foreground.
-   * @param graphics Graphics object to render to
+   * @param list Display list to record the drawing into
    */
-    virtual void DrawComponentForeground(std::shared_ptr<wxGraphicsContext> graphics) = 0;
+    virtual void DrawComponentForeground(DisplayList &list) const = 0;
 
 
     /**
@@ -46,12 +54,12 @@ public:
      * Get X location of component
      * @return x location
      */
-    double GetX() { return mLocation.x; }
+    double GetX() const { return mLocation.x; }
     /**
      * Get  Y location of component
      * @return y location
      */
-    double GetY() { return mLocation.y; }
+    double GetY() const { return mLocation.y; }
 
     /**
      * Location setter for component images
@@ -60,7 +68,9 @@ public:
     void SetLocation(wxPoint loc) { mLocation = loc; }
 
     /**
-     * Set the time
+     * Set the time.
+     * Once the component is bound to a machine its time
+     * is the machine time and this has no effect.
      * @param time time
      */
     void SetTime(double time)
@@ -69,19 +79,78 @@ public:
     }
 
     /**
-     * Advance the animation time
-     * @param increase
+     * Bind this component to the store of the machine it is added to.
+     * Components move their per frame state into the store here.
+     * @param store Component store of the machine
      */
-    virtual void Advance(double increase)
+    virtual void Bind(ComponentStore &store)
     {
-        mTime += increase;
+        mClock = store.GetClock();
     }
 
+    /**
+     * Advance an animation of the component's own.
+     * Only called on components that added themselves with
+     * ComponentStore::AddAnimated when bound. The store turns the
+     * cranks, and with them the drive graph, itself. The machine clock
+     * is already at the new time when this is called.
+     * @param increase Amount of time to advance in seconds
+     */
+    virtual void Advance(double increase) {}
+
+    /**
+     * Evaluate this component's state directly from the machine time.
+     * Called by Machine::Seek after every component has been reset
+     * and given the target time.
+     * @param time Machine time in seconds
+     */
+    virtual void Seek(double time) {}
+
+    /**
+     * Set if the machine is seeking rather than playing.
+     * Components with side effects (like sound) suppress them while seeking.
+     * @param seeking True while the machine is seeking
+     */
+    virtual void SetSeeking(bool seeking) {}
+
+    /**
+     * Mute any sound this component makes
+     * @param mute True to mute
+     */
+    virtual void Mute(bool mute) {}
+
+    /**
+     * Set a recorder that receives every sound this component makes.
+     * Recording is not affected by muting.
+     * @param recorder Recorder to use or nullptr to stop recording
+     */
+    virtual void SetRecorder(AudioRecorder *recorder) {}
+
+    /**
+     * Compile any rotation drive graph this component is the root of.
+     * Called once the machine has been built.
+     */
+    virtual void Compile() {}
+
+    /**
+     * Save the simulation state of this component.
+     * The component time is the machine time, which the
+     * machine saves once for the whole checkpoint.
+     * @param checkpoint Checkpoint to write the state to
+     */
+    virtual void SaveState(Checkpoint &checkpoint) {}
+
+    /**
+     * Restore the simulation state of this component
+     * @param checkpoint Checkpoint to read the state from
+     */
+    virtual void RestoreState(Checkpoint &checkpoint) {}
+
     /**
      * Get time
      * @return time in seconds
      */
-    double GetTime() { return mTime; }
+    double GetTime() const { return *mClock; }
 };
 
 
@@ -0,0 +1,169 @@
+/**
+ * @file ComponentProfiler.cpp
+ * @author Jaylon Sifuentes
+ */
+
+#include "pch.h"
+#include <cstdlib>
+#include <memory>
+#include "ComponentProfiler.h"
+
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
+
+/// The active profiler on each thread
+static thread_local ComponentProfiler *ActiveProfiler = nullptr;
+
+/**
+ * Get a readable name for a type
+ * @param type Type to name
+ * @return Name of the type without any namespace or class keyword
+ */
+std::string ComponentProfiler::TypeName(const std::type_info &type)
+{
+    std::string name = type.name();
+#ifdef __GNUG__
+    int status = 0;
+    std::unique_ptr<char, void (*)(void *)> demangled(
+        abi::__cxa_demangle(type.name(), nullptr, nullptr, &status), std::free);
+    if (status == 0)
+    {
+        name = demangled.get();
+    }
+#endif
+
+    auto space = name.rfind(' ');
+    if (space != std::string::npos)
+    {
+        name = name.substr(space + 1);
+    }
+
+    auto scope = name.rfind("::");
+    if (scope != std::string::npos)
+    {
+        name = name.substr(scope + 2);
+    }
+
+    return name;
+}
+
+/**
+ * Constructor
+ * @param profiler Profiler to make active, or nullptr for none
+ */
+ComponentProfiler::Activation::Activation(ComponentProfiler *profiler) : mPrevious(ActiveProfiler)
+{
+    ActiveProfiler = profiler;
+}
+
+/**
+ * Destructor. Makes the previous profiler active again.
+ */
+ComponentProfiler::Activation::~Activation()
+{
+    ActiveProfiler = mPrevious;
+}
+
+/**
+ * Get the active profiler on this thread
+ * @return Active profiler or nullptr if there is none
+ */
+ComponentProfiler *ComponentProfiler::Active()
+{
+    return ActiveProfiler;
+}
+
+/**
+ * Add a timing
+ * @param type Type of the object that was timed
+ * @param phase Phase that was timed
+ * @param nanoseconds Timing in nanoseconds
+ */
+void ComponentProfiler::Add(const std::type_info &type, Phase phase, double nanoseconds)
+{
+    auto found = mIndex.find(type);
+    if (found == mIndex.end())
+    {
+        found = mIndex.emplace(type, mTypes.size()).first;
+        mTypes.emplace_back();
+        mTypes.back().mName = TypeName(type);
+    }
+
+    mTypes[found->second].mPhases[(int)phase].Add(nanoseconds);
+}
+
+/**
+ * Get the names of the types that have timings
+ * @return Type names in the order they were first timed
+ */
+std::vector<std::string> ComponentProfiler::GetTypes() const
+{
+    std::vector<std::string> names;
+    for (auto &type : mTypes)
+    {
+        names.push_back(type.mName);
+    }
+
+    return names;
+}
+
+/**
+ * Get the timings of one phase of a component type
+ * @param type Name of the type, as returned by GetTypes
+ * @param phase Phase
+ * @return Histogram of the timings or nullptr if the type has none
+ */
+const TimingHistogram *ComponentProfiler::GetHistogram(const std::string &type, Phase phase) const
+{
+    for (auto &timings : mTypes)
+    {
+        if (timings.mName == type)
+        {
+            return &timings.mPhases[(int)phase];
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * Get the name of a phase
+ * @param phase Phase
+ * @return Name of the component call the phase times
+ */
+const char *ComponentProfiler::PhaseName(Phase phase)
+{
+    switch (phase)
+    {
+    case Phase::Advance:
+        return "Advance";
+
+    case Phase::DrawBackground:
+        return "DrawComponentBackground";
+
+    case Phase::DrawForeground:
+        return "DrawComponentForeground";
+    }
+
+    return "";
+}
+
+/**
+ * Record a trace span for a component call
+ * @param type Type of the component
+ * @param phase Phase that was timed
+ * @param start Time the call started
+ * @param nanoseconds Duration of the call in nanoseconds
+ */
+void ComponentProfiler::Trace(const std::type_info &type, Phase phase, std::chrono::steady_clock::time_point start,
+                              double nanoseconds)
+{
+    Tracer::Event event;
+    event.mName = PhaseName(phase);
+    event.mType = &type;
+    event.mCategory = phase == Phase::DrawBackground || phase == Phase::DrawForeground ? "draw" : "simulate";
+    event.mStart = std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count();
+    event.mDuration = (int64_t)nanoseconds;
+    Tracer::Record(event);
+}
@@ -0,0 +1,183 @@
+/**
+ * @file ComponentProfiler.h
+ * @author Jaylon Sifuentes
+ *
+ * Class that times component calls by component type.
+ */
+
+#ifndef COMPONENTPROFILER_H
+#define COMPONENTPROFILER_H
+
+#include <array>
+#include <chrono>
+#include <map>
+#include <string>
+#include <typeindex>
+#include <vector>
+#include "TimingHistogram.h"
+#include "Tracer.h"
+
+/**
+ * Times the simulation and draw calls of components and keeps
+ * a rolling histogram of the timings for each component type.
+ *
+ * A machine activates its profiler, if it has one, for the
+ * duration of Advance and Draw. Scopes in the call sites only
+ * time anything while a profiler is active or the Tracer is
+ * running, and also record a trace span while it is. When both
+ * are off the cost is one thread local read and one atomic load
+ * per scope.
+ */
+class ComponentProfiler
+{
+public:
+    /// The component calls that are timed
+    enum class Phase { Advance, DrawBackground, DrawForeground };
+
+    /// Number of phases
+    static constexpr int PhaseCount = 3;
+
+    /**
+     * Times one call while a profiler is active
+     */
+    class Scope
+    {
+    private:
+        /// Profiler to add the timing to, or nullptr if none is active
+        ComponentProfiler *mProfiler;
+        /// True if a trace span is recorded
+        bool mTracing;
+        /// Type of the object being timed
+        const std::type_info *mType = nullptr;
+        /// Phase being timed
+        Phase mPhase = Phase::Advance;
+        /// Time the call started
+        std::chrono::steady_clock::time_point mStart;
+
+    public:
+        /**
+         * Constructor. Starts timing if a profiler is active.
+         * @param object Object whose call is timed
+         * @param phase Phase being timed
+         */
+        template<class T>
+        Scope(const T &object, Phase phase) : mProfiler(Active()), mTracing(Tracer::IsEnabled())
+        {
+            if (mProfiler != nullptr || mTracing)
+            {
+                mType = &typeid(object);
+                mPhase = phase;
+                mStart = std::chrono::steady_clock::now();
+            }
+        }
+
+        /**
+         * Constructor. Starts timing if a profiler is active.
+         * @param type Type to add the timing to
+         * @param phase Phase being timed
+         */
+        Scope(const std::type_info &type, Phase phase) : mProfiler(Active()), mTracing(Tracer::IsEnabled())
+        {
+            if (mProfiler != nullptr || mTracing)
+            {
+                mType = &type;
+                mPhase = phase;
+                mStart = std::chrono::steady_clock::now();
+            }
+        }
+
+        /// delete the copy constructor
+        Scope(const Scope&) = delete;
+
+        /// delete the copy assignment operator
+        Scope& operator=(const Scope&) = delete;
+
+        /**
+         * Destructor. Adds the timing to the profiler and the trace.
+         */
+        ~Scope()
+        {
+            if (mProfiler == nullptr && !mTracing)
+            {
+                return;
+            }
+
+            std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - mStart;
+            if (mProfiler != nullptr)
+            {
+                mProfiler->Add(*mType, mPhase, elapsed.count());
+            }
+
+            if (mTracing)
+            {
+                Trace(*mType, mPhase, mStart, elapsed.count());
+            }
+        }
+    };
+
+    /**
+     * Makes a profiler the active one on this thread while it exists
+     */
+    class Activation
+    {
+    private:
+        /// The profiler that was active before
+        ComponentProfiler *mPrevious;
+
+    public:
+        explicit Activation(ComponentProfiler *profiler);
+        ~Activation();
+
+        /// delete the copy constructor
+        Activation(const Activation&) = delete;
+
+        /// delete the copy assignment operator
+        Activation& operator=(const Activation&) = delete;
+    };
+
+private:
+    /**
+     * Timings of one component type
+     */
+    struct TypeTimings
+    {
+        /// Readable name of the type
+        std::string mName;
+        /// Timings of each phase
+        std::array<TimingHistogram, PhaseCount> mPhases;
+    };
+
+    /// Index into mTypes of each type seen
+    std::map<std::type_index, size_t> mIndex;
+
+    /// Timings of each type seen, in the order they were first seen
+    std::vector<TypeTimings> mTypes;
+
+public:
+    static ComponentProfiler *Active();
+
+    void Add(const std::type_info &type, Phase phase, double nanoseconds);
+
+    std::vector<std::string> GetTypes() const;
+
+    const TimingHistogram *GetHistogram(const std::string &type, Phase phase) const;
+
+    /**
+     * Remove all timings
+     */
+    void Clear()
+    {
+        mIndex.clear();
+        mTypes.clear();
+    }
+
+    static const char *PhaseName(Phase phase);
+
+    static std::string TypeName(const std::type_info &type);
+
+    static void Trace(const std::type_info &type, Phase phase, std::chrono::steady_clock::time_point start,
+                      double nanoseconds);
+};
+
+
+#endif //COMPONENTPROFILER_H
@@ -0,0 +1,62 @@
+/**
+ * @file ComponentStore.cpp
+ * @author Jaylon Sifuentes
+ */
+
+#include "pch.h"
+#include "ComponentStore.h"
+#include "Component.h"
+#include "ComponentProfiler.h"
+#include "Crank.h"
+#include "RotationSource.h"
+
+/**
+ * Add a crank to the store
+ * @param rotation Initial rotation of the crank in turns
+ * @param speed Speed of the crank in turns per second
+ * @param ratio Ratio from the crank rotation to the rotation it drives
+ * @param source Rotation source turned by the crank
+ * @return Pointer to the crank rotation storage
+ */
+double *ComponentStore::AddCrank(double rotation, double speed, double ratio, RotationSource *source)
+{
+    double *storage = AddRotation(rotation);
+    mCrankRotations.push_back(storage);
+    mCrankSpeeds.push_back(speed);
+    mCrankRatios.push_back(ratio);
+    mCrankSources.push_back(source);
+    return storage;
+}
+
+/**
+ * Advance the machine clock and every bound component.
+ *
+ * Animated components advance before the cranks turn, so a key
+ * that drops during this frame starts its animation from the
+ * drop time rather than being advanced twice.
+ *
+ * @param increase Amount of time to advance in seconds
+ */
+void ComponentStore::Advance(double increase)
+{
+    mTime += increase;
+
+    for (auto component : mAnimated)
+    {
+        ComponentProfiler::Scope scope(*component, ComponentProfiler::Phase::Advance);
+        component->Advance(increase);
+    }
+
+    const size_t cranks = mCrankRotations.size();
+    for (size_t i = 0; i < cranks; i++)
+    {
+        *mCrankRotations[i] += increase * mCrankSpeeds[i];
+    }
+
+    for (size_t i = 0; i < cranks; i++)
+    {
+        // Timed as the crank's Advance, including everything it drives
+        ComponentProfiler::Scope scope(typeid(Crank), ComponentProfiler::Phase::Advance);
+        mCrankSources[i]->SetRotation(*mCrankRotations[i] * mCrankRatios[i]);
+    }
+}
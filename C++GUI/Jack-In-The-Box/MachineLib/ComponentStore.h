@@ -0,0 +1,115 @@
+/**
+ * @file ComponentStore.h
+ * @author Jaylon Sifuentes
+ *
+ * Class that holds the simulation state of a machine's components.
+ */
+
+#ifndef COMPONENTSTORE_H
+#define COMPONENTSTORE_H
+
+#include <deque>
+#include <memory_resource>
+#include <vector>
+
+class Component;
+class RotationSource;
+
+/**
+ * Structure of arrays holding the per frame simulation state of
+ * every component in a machine.
+ *
+ * Components bind to the store when they are added to a machine.
+ * The machine clock is kept once here instead of in every component,
+ * the rotation of every crank, shaft and pulley lives in one packed
+ * array, and the cranks are advanced by a single loop over their
+ * speeds. Only components with their own animation (the box and
+ * Sparty) are still advanced through Component::Advance.
+ *
+ * Rotation storage never moves once handed out, so drive tables may
+ * keep pointers to it. Drive tables must be built after the components
+ * have been added to the machine.
+ *
+ * The arrays are allocated from the machine's arena.
+ */
+class ComponentStore
+{
+private:
+    /// Machine time in seconds, shared by every bound component
+    double mTime = 0;
+
+    /// Rotation of every crank, shaft and pulley in turns.
+    /// A deque keeps the storage in blocks whose elements never move.
+    std::pmr::deque<double> mRotations;
+
+    /// Rotation storage of each crank
+    std::pmr::vector<double*> mCrankRotations;
+    /// Speed of each crank in turns per second
+    std::pmr::vector<double> mCrankSpeeds;
+    /// Ratio from each crank rotation to the rotation it drives
+    std::pmr::vector<double> mCrankRatios;
+    /// Rotation source turned by each crank
+    std::pmr::vector<RotationSource*> mCrankSources;
+
+    /// Components with an animation of their own
+    std::pmr::vector<Component*> mAnimated;
+
+public:
+    /**
+     * Constructor
+     * @param resource Memory resource to allocate the arrays from
+     */
+    explicit ComponentStore(std::pmr::memory_resource *resource) :
+        mRotations(resource), mCrankRotations(resource), mCrankSpeeds(resource),
+        mCrankRatios(resource), mCrankSources(resource), mAnimated(resource)
+    {
+    }
+
+    /// delete the copy constructor
+    ComponentStore(const ComponentStore&) = delete;
+
+    /// delete the copy assignment operator
+    ComponentStore& operator=(const ComponentStore&) = delete;
+
+    /**
+     * Get the machine clock bound components read their time from
+     * @return Pointer to the machine time in seconds
+     */
+    const double *GetClock() const { return &mTime; }
+
+    /**
+     * Get the machine time
+     * @return Machine time in seconds
+     */
+    double GetTime() const { return mTime; }
+
+    /**
+     * Set the machine time
+     * @param time Machine time in seconds
+     */
+    void SetTime(double time) { mTime = time; }
+
+    /**
+     * Add storage for the rotation of a component
+     * @param rotation Initial rotation in turns
+     * @return Pointer to the rotation storage
+     */
+    double *AddRotation(double rotation)
+    {
+        mRotations.push_back(rotation);
+        return &mRotations.back();
+    }
+
+    double *AddCrank(double rotation, double speed, double ratio, RotationSource *source);
+
+    /**
+     * Add a component that is advanced every frame
+     * @param component Component to advance
+     */
+    void AddAnimated(Component *component) { mAnimated.push_back(component); }
+
+    void Advance(double increase);
+};
+
+
+#endif //COMPONENTSTORE_H
@@ -7,6 +7,7 @@
 
 #include "pch.h"
 #include "Crank.h"
+#include "DisplayList.h"
 #include "RotationSource.h"
 
 /// The width of the crank on the screen in pixels
@@ -67,20 +68,20 @@ Crank::Crank(wxPoint location) : mRotationSource()
     mSpeed = 5;
 }
 
-void Crank::DrawComponentBackground(std::shared_ptr<wxGraphicsContext> graphics)
+void Crank::DrawComponentBackground(DisplayList &list) const
 {
 }
 
-void Crank::DrawComponentForeground(std::shared_ptr<wxGraphicsContext> graphics)
+void Crank::DrawComponentForeground(DisplayList &list) const
 {
-    double handleY = GetY() + cos(mRotation) * CrankLength;
-    mHandle.Draw(graphics, HandleXOffset, HandleYOffset + handleY, mRotation);
+    double handleY = GetY() + cos(*mRotation) * CrankLength;
+    list.DrawCylinder(mHandle, HandleXOffset, HandleYOffset + handleY, *mRotation);
 
     // Calculate scaler based on crank position
     double distanceFromHandle = -(handleY);
     double scaler = 1.0 + ((distanceFromHandle) / (CrankLength / 2));
     // Draw the rectangle that always remains
-    mCrank.DrawPolygon(graphics, CrankXOffset, CrankYOffset);
+    list.DrawPolygon(mCrank, CrankXOffset, CrankYOffset);
     // Apply small offset to scaler so rect goes over the handle
     double rectangleOffset = 0;
     if(scaler < 0)
@@ -92,16 +93,16 @@ void Crank::DrawComponentForeground(std::shared_ptr<wxGraphicsContext> graphics)
     }
     // Draw the connecting rectangle that "follows" the handle.
     // Does this by resizing.
-    graphics->PushState();
-    graphics->Translate(0, CrankYOffset);
-    graphics->Scale(1,  scaler + rectangleOffset);
-     mCrank.DrawPolygon(graphics, CrankXOffset, 0);
-    graphics->PopState();
+    list.PushState();
+    list.Translate(0, CrankYOffset);
+    list.Scale(1,  scaler + rectangleOffset);
+     list.DrawPolygon(mCrank, CrankXOffset, 0);
+    list.PopState();
 }
 
 void Crank::Reset()
 {
-    mRotation = 0;
+    *mRotation = 0;
 }
 
 
@@ -110,9 +111,28 @@ void Crank::Reset()
  * This is used to slow down the shaft relative to the crank.
  */
 const float speedMult = 0.2f;
-void Crank::Advance(double increase)
+
+void Crank::Bind(ComponentStore &store)
+{
+    Component::Bind(store);	// Upcall
+    mRotation = store.AddCrank(*mRotation, mSpeed, speedMult, &mRotationSource);
+}
+
+void Crank::Seek(double time)
+{
+    // The crank turns at a constant speed, so its rotation is a closed form of time
+    *mRotation = time * mSpeed;
+    mRotationSource.SetRotation(*mRotation * speedMult);
+}
+
+void Crank::SaveState(Checkpoint &checkpoint)
+{
+    Component::SaveState(checkpoint);	// Upcall
+    checkpoint.Write(*mRotation);
+}
+
+void Crank::RestoreState(Checkpoint &checkpoint)
 {
-    Component::Advance(increase);
-    mRotation += increase * mSpeed;
-    mRotationSource.SetRotation(mRotation * speedMult); // Set the rotation of the rotation source
+    Component::RestoreState(checkpoint);	// Upcall
+    *mRotation = checkpoint.Read();
 }
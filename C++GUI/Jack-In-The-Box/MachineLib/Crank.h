@@ -27,8 +27,11 @@ private:
     /// Rotation source associated with crank
     RotationSource mRotationSource;
 
-    /// Rotation of the crank in turns
-    double mRotation = 0;
+    /// Rotation of the crank in turns while it is not part of a machine
+    double mUnboundRotation = 0;
+    /// Rotation of the crank in turns.
+    /// Points into the machine's component store once bound.
+    double *mRotation = &mUnboundRotation;
     /// Speed the crank rotates at
     double mSpeed;
 
@@ -48,15 +51,15 @@ public:
 
     /**
     * Draw the component at the currently specified location in the background.
-    * @param graphics Graphics object to render to
+    * @param list Display list to record the drawing into
     */
-    void DrawComponentBackground(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void DrawComponentBackground(DisplayList &list) const override;
 
     /**
     * Draw the component at the currently specified location in the foreground.
-    * @param graphics Graphics object to render to
+    * @param list Display list to record the drawing into
     */
-    void DrawComponentForeground(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void DrawComponentForeground(DisplayList &list) const override;
 
     /**
     * Reset this component
@@ -64,10 +67,33 @@ public:
     void Reset() override;
 
     /**
-    * Advance this components animation time
-    * @param increase Amount of time to advance in seconds
+    * Add the crank to the machine's component store, which turns it from then on
+    * @param store Component store of the machine
     */
-    void Advance(double increase) override;
+    void Bind(ComponentStore &store) override;
+
+    /**
+     * Save the simulation state of this component
+     * @param checkpoint Checkpoint to write the state to
+     */
+    void SaveState(Checkpoint &checkpoint) override;
+
+    /**
+     * Restore the simulation state of this component
+     * @param checkpoint Checkpoint to read the state from
+     */
+    void RestoreState(Checkpoint &checkpoint) override;
+
+    /**
+    * Set the crank rotation directly from the machine time
+    * @param time Machine time in seconds
+    */
+    void Seek(double time) override;
+
+    /**
+    * Compile the drive graph turned by this crank
+    */
+    void Compile() override { mRotationSource.Compile(); }
 
     /** Get a pointer to the source object
     * @return Pointer to RotationSource object
@@ -21,20 +21,23 @@ namespace cse335
  * @param y Y location of left center end of cylinder
  * @param rotation Current rotation angle in turns
  */
-void Cylinder::Draw(const std::shared_ptr<wxGraphicsContext> &graphics, double x, double y, double rotation)
+void Cylinder::Draw(const std::shared_ptr<wxGraphicsContext> &graphics, double x, double y, double rotation) const
 {
-    wxBrush cylinderBrush(mColor);
-    graphics->SetBrush(cylinderBrush);
-    if(mBorderColor != wxTRANSPARENT)
+    if(mDirty || graphics->GetRenderer() != mRenderer)
     {
-        wxPen cylinderPen(mBorderColor);
-        graphics->SetPen(cylinderPen);
-    }
-    else
-    {
-        graphics->SetPen(*wxTRANSPARENT_PEN);
+        mBrush = graphics->CreateBrush(wxBrush(mColor));
+        mBorderPen = mBorderColor != wxTRANSPARENT ? graphics->CreatePen(wxPen(mBorderColor)) : wxGraphicsPen();
+
+        wxPen linePen(mLineColor, mLineWidth);
+        linePen.SetCap(wxCAP_BUTT);
+        mLinePen = graphics->CreatePen(linePen);
+        mRenderer = graphics->GetRenderer();
+        mDirty = false;
     }
 
+    graphics->SetBrush(mBrush);
+    graphics->SetPen(mBorderPen);
+
     // Draw the rod
     graphics->DrawRectangle(x, y - mDiameter / 2.0, mLength, mDiameter);
 
@@ -43,10 +46,7 @@ void Cylinder::Draw(const std::shared_ptr<wxGraphicsContext> &graphics, double x
 
     if(mNumLines > 0)
     {
-        // The lines we'll draw
-        wxPen linePen(mLineColor, mLineWidth);
-        linePen.SetCap(wxCAP_BUTT);
-        graphics->SetPen(linePen);
+        graphics->SetPen(mLinePen);
 
         for(int i = 0; i < mNumLines; i++)
         {
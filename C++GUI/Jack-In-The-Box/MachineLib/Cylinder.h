@@ -28,13 +28,13 @@ private:
     int mLength = 0;
 
     /// The color to draw the cylinder
-    wxColour mColor = *wxWHITE;
+    wxColour mColor = wxColour(255, 255, 255);
 
     /// The color to draw the border around the cylinder
-    wxColour mBorderColor = *wxBLACK;
+    wxColour mBorderColor = wxColour(0, 0, 0);
 
     /// The color to draw the moving lines on the cylinder
-    wxColour mLineColor = *wxBLACK;
+    wxColour mLineColor = wxColour(0, 0, 0);
 
     /// The width to draw the moving lines
     int mLineWidth = 1;
@@ -45,6 +45,34 @@ private:
     /// Offset to prevent the lines from all lining up
     double mOffset = 0;
 
+    /// Brush to fill the cylinder with (created on first draw)
+    mutable wxGraphicsBrush mBrush;
+
+    /// Pen to draw the border with, null if there is no border
+    mutable wxGraphicsPen mBorderPen;
+
+    /// Pen to draw the moving lines with
+    mutable wxGraphicsPen mLinePen;
+
+    /// Set when the brush and pens must be created again
+    mutable bool mDirty = true;
+
+    /// Renderer the brush and pens were created with
+    mutable wxGraphicsRenderer *mRenderer = nullptr;
+
+    /**
+     * Copy a color without sharing its data with the original.
+     * wxWidgets reference counts are not thread safe, and the colors
+     * passed in are often stock or file scope colors that machines
+     * drawn on other threads also use.
+     * @param color Color to copy
+     * @return Copy of the color
+     */
+    static wxColour Copy(const wxColour &color)
+    {
+        return wxColour(color.Red(), color.Green(), color.Blue(), color.Alpha());
+    }
+
 public:
     /**
      * Constructor
@@ -72,13 +100,13 @@ public:
      * Set the cylinder color
      * @param color Color to draw the cylinder
      */
-    void SetColour(const wxColour &color) { mColor = color; }
+    void SetColour(const wxColour &color) { mColor = Copy(color); mDirty = true; }
 
     /**
      * Set the border color drawn around the cylinder
      * @param color Color to set
      */
-    void SetBorderColor(const wxColour &color) {mBorderColor = color;}
+    void SetBorderColor(const wxColour &color) {mBorderColor = Copy(color); mDirty = true;}
 
     /**
      * Set lines that appear on the cylinder that show it is turning
@@ -88,9 +116,10 @@ public:
      */
     void SetLines(const wxColour &color, int width, int num)
     {
-        mLineColor = color;
+        mLineColor = Copy(color);
         mLineWidth = width;
         mNumLines = num;
+        mDirty = true;
     }
 
     /**
@@ -104,7 +133,7 @@ public:
      */
     void SetOffset(double offset) {mOffset = offset;}
 
-    void Draw(const std::shared_ptr<wxGraphicsContext> &graphics, double x, double y, double rotation);
+    void Draw(const std::shared_ptr<wxGraphicsContext> &graphics, double x, double y, double rotation) const;
 };
 
 }
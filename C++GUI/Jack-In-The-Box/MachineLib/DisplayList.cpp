@@ -0,0 +1,368 @@
+/**
+ * @file DisplayList.cpp
+ * @author Jaylon Sifuentes
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include "DisplayList.h"
+#include "Polygon.h"
+#include "Cylinder.h"
+
+/**
+ * Find an object in a resource table, adding it if it is not there
+ * @param table Table to search
+ * @param object Brush or pen to find
+ * @return Index of the object in the table
+ */
+template<class T, class G>
+static int Intern(std::vector<T> &table, const G &object)
+{
+    for (size_t i = 0; i < table.size(); i++)
+    {
+        if (table[i].mObject == object)
+        {
+            return (int)i;
+        }
+    }
+
+    table.push_back({object, {}});
+    return (int)table.size() - 1;
+}
+
+/**
+ * Record a command.
+ *
+ * If the command at the current position has the same operation and
+ * uses the same object it is returned to be patched. Otherwise the
+ * list is truncated there and a new command is appended.
+ *
+ * @param op Operation
+ * @param resource Index of the brush or pen the command uses
+ * @param object Polygon or cylinder the command draws
+ * @return Command whose parameters are to be set
+ */
+DisplayList::Command &DisplayList::Record(Op op, int resource, const void *object)
+{
+    if (mPosition < mCommands.size())
+    {
+        auto &command = mCommands[mPosition];
+        if (command.mOp == op && command.mResource == resource && command.mObject == object)
+        {
+            mPosition++;
+            mPatched++;
+            return command;
+        }
+
+        mCommands.resize(mPosition);
+    }
+
+    Command command;
+    command.mOp = op;
+    command.mResource = resource;
+    command.mObject = object;
+    mCommands.push_back(command);
+    mPosition++;
+    mAppended++;
+    return mCommands.back();
+}
+
+/**
+ * Finish recording. Discards any commands left over from
+ * a longer recording.
+ */
+void DisplayList::End()
+{
+    if (mPosition < mCommands.size())
+    {
+        mCommands.resize(mPosition);
+    }
+}
+
+/**
+ * Replay the recorded commands
+ * @param graphics Graphics context to draw on
+ */
+void DisplayList::Replay(std::shared_ptr<wxGraphicsContext> graphics)
+{
+    Replay(graphics, 0, mCommands.size());
+}
+
+/**
+ * Replay a range of the recorded commands
+ * @param graphics Graphics context to draw on
+ * @param begin Index of the first command to replay
+ * @param end Index past the last command to replay
+ */
+void DisplayList::Replay(std::shared_ptr<wxGraphicsContext> graphics, size_t begin, size_t end)
+{
+    if (graphics->GetRenderer() != mRenderer)
+    {
+        // Graphics objects only work with the renderer that created them
+        for (auto &brush : mBrushes)
+        {
+            brush.mGraphics = wxGraphicsBrush();
+        }
+
+        for (auto &pen : mPens)
+        {
+            pen.mGraphics = wxGraphicsPen();
+        }
+
+        mRenderer = graphics->GetRenderer();
+    }
+
+    end = std::min(end, mCommands.size());
+    for (size_t i = begin; i < end; i++)
+    {
+        const auto &command = mCommands[i];
+        const double *params = command.mParams;
+        switch (command.mOp)
+        {
+        case Op::PushState:
+            graphics->PushState();
+            break;
+
+        case Op::PopState:
+            graphics->PopState();
+            break;
+
+        case Op::Translate:
+            graphics->Translate(params[0], params[1]);
+            break;
+
+        case Op::Rotate:
+            graphics->Rotate(params[0]);
+            break;
+
+        case Op::Scale:
+            graphics->Scale(params[0], params[1]);
+            break;
+
+        case Op::SetBrush:
+        {
+            auto &brush = mBrushes[command.mResource];
+            if (brush.mGraphics.IsNull() && brush.mObject.IsOk() &&
+                brush.mObject.GetStyle() != wxBRUSHSTYLE_TRANSPARENT)
+            {
+                brush.mGraphics = graphics->CreateBrush(brush.mObject);
+            }
+            graphics->SetBrush(brush.mGraphics);
+            break;
+        }
+
+        case Op::SetPen:
+        {
+            auto &pen = mPens[command.mResource];
+            if (pen.mGraphics.IsNull() && pen.mObject.IsOk() &&
+                pen.mObject.GetStyle() != wxPENSTYLE_TRANSPARENT)
+            {
+                pen.mGraphics = graphics->CreatePen(pen.mObject);
+            }
+            graphics->SetPen(pen.mGraphics);
+            break;
+        }
+
+        case Op::DrawRectangle:
+            graphics->DrawRectangle(params[0], params[1], params[2], params[3]);
+            break;
+
+        case Op::DrawEllipse:
+            graphics->DrawEllipse(params[0], params[1], params[2], params[3]);
+            break;
+
+        case Op::MoveToPoint:
+            mPath = graphics->CreatePath();
+            mPath.MoveToPoint(params[0], params[1]);
+            break;
+
+        case Op::AddCurveToPoint:
+            mPath.AddCurveToPoint(params[0], params[1], params[2], params[3], params[4], params[5]);
+            break;
+
+        case Op::StrokePath:
+            graphics->StrokePath(mPath);
+            break;
+
+        case Op::DrawPolygon:
+            static_cast<const cse335::Polygon *>(command.mObject)->DrawPolygon(graphics, params[0], params[1],
+                                                                              params[2]);
+            break;
+
+        case Op::DrawCylinder:
+            static_cast<const cse335::Cylinder *>(command.mObject)->Draw(graphics, params[0], params[1], params[2]);
+            break;
+        }
+    }
+}
+
+/**
+ * Record saving the graphics state
+ */
+void DisplayList::PushState()
+{
+    Record(Op::PushState);
+}
+
+/**
+ * Record restoring the graphics state
+ */
+void DisplayList::PopState()
+{
+    Record(Op::PopState);
+}
+
+/**
+ * Record a translation
+ * @param x X offset in pixels
+ * @param y Y offset in pixels
+ */
+void DisplayList::Translate(double x, double y)
+{
+    auto &command = Record(Op::Translate);
+    command.mParams[0] = x;
+    command.mParams[1] = y;
+}
+
+/**
+ * Record a rotation
+ * @param angle Rotation angle in radians
+ */
+void DisplayList::Rotate(double angle)
+{
+    Record(Op::Rotate).mParams[0] = angle;
+}
+
+/**
+ * Record a scaling
+ * @param x X scale
+ * @param y Y scale
+ */
+void DisplayList::Scale(double x, double y)
+{
+    auto &command = Record(Op::Scale);
+    command.mParams[0] = x;
+    command.mParams[1] = y;
+}
+
+/**
+ * Record setting the brush
+ * @param brush Brush to fill with
+ */
+void DisplayList::SetBrush(const wxBrush &brush)
+{
+    Record(Op::SetBrush, Intern(mBrushes, brush));
+}
+
+/**
+ * Record setting the pen
+ * @param pen Pen to stroke with
+ */
+void DisplayList::SetPen(const wxPen &pen)
+{
+    Record(Op::SetPen, Intern(mPens, pen));
+}
+
+/**
+ * Record drawing a rectangle
+ * @param x Left side in pixels
+ * @param y Top in pixels
+ * @param width Width in pixels
+ * @param height Height in pixels
+ */
+void DisplayList::DrawRectangle(double x, double y, double width, double height)
+{
+    auto &command = Record(Op::DrawRectangle);
+    command.mParams[0] = x;
+    command.mParams[1] = y;
+    command.mParams[2] = width;
+    command.mParams[3] = height;
+}
+
+/**
+ * Record drawing an ellipse
+ * @param x Left side of the bounding box in pixels
+ * @param y Top of the bounding box in pixels
+ * @param width Width in pixels
+ * @param height Height in pixels
+ */
+void DisplayList::DrawEllipse(double x, double y, double width, double height)
+{
+    auto &command = Record(Op::DrawEllipse);
+    command.mParams[0] = x;
+    command.mParams[1] = y;
+    command.mParams[2] = width;
+    command.mParams[3] = height;
+}
+
+/**
+ * Record starting a new path
+ * @param x X of the first point in pixels
+ * @param y Y of the first point in pixels
+ */
+void DisplayList::MoveToPoint(double x, double y)
+{
+    auto &command = Record(Op::MoveToPoint);
+    command.mParams[0] = x;
+    command.mParams[1] = y;
+}
+
+/**
+ * Record adding a cubic Bezier curve to the path
+ * @param cx1 X of the first control point
+ * @param cy1 Y of the first control point
+ * @param cx2 X of the second control point
+ * @param cy2 Y of the second control point
+ * @param x X of the end point
+ * @param y Y of the end point
+ */
+void DisplayList::AddCurveToPoint(double cx1, double cy1, double cx2, double cy2, double x, double y)
+{
+    auto &command = Record(Op::AddCurveToPoint);
+    command.mParams[0] = cx1;
+    command.mParams[1] = cy1;
+    command.mParams[2] = cx2;
+    command.mParams[3] = cy2;
+    command.mParams[4] = x;
+    command.mParams[5] = y;
+}
+
+/**
+ * Record stroking the path
+ */
+void DisplayList::StrokePath()
+{
+    Record(Op::StrokePath);
+}
+
+/**
+ * Record drawing a polygon.
+ * The polygon must exist until the list is recorded again.
+ * @param polygon Polygon to draw
+ * @param x X location in pixels
+ * @param y Y location in pixels
+ * @param rotation Rotation in turns
+ */
+void DisplayList::DrawPolygon(const cse335::Polygon &polygon, double x, double y, double rotation)
+{
+    auto &command = Record(Op::DrawPolygon, -1, &polygon);
+    command.mParams[0] = x;
+    command.mParams[1] = y;
+    command.mParams[2] = rotation;
+}
+
+/**
+ * Record drawing a cylinder.
+ * The cylinder must exist until the list is recorded again.
+ * @param cylinder Cylinder to draw
+ * @param x X location of the left center end in pixels
+ * @param y Y location of the left center end in pixels
+ * @param rotation Rotation in turns
+ */
+void DisplayList::DrawCylinder(const cse335::Cylinder &cylinder, double x, double y, double rotation)
+{
+    auto &command = Record(Op::DrawCylinder, -1, &cylinder);
+    command.mParams[0] = x;
+    command.mParams[1] = y;
+    command.mParams[2] = rotation;
+}
@@ -0,0 +1,167 @@
+/**
+ * @file DisplayList.h
+ * @author Jaylon Sifuentes
+ *
+ * Class that records drawing commands so they can be replayed.
+ */
+
+#ifndef DISPLAYLIST_H
+#define DISPLAYLIST_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cse335
+{
+class Polygon;
+class Cylinder;
+}
+
+/**
+ * A retained list of drawing commands.
+ *
+ * Components record into the list with the same calls they would
+ * make on a wxGraphicsContext, and the list is replayed onto a
+ * context to draw them. Polygons and cylinders are recorded as a
+ * single command that refers to the object, so they keep their own
+ * cached paths and bitmaps.
+ *
+ * Recording again over an existing list only patches the parameters
+ * of each command while the sequence of commands is the same as last
+ * time, so a frame that only moves things allocates nothing. If the
+ * sequence differs the rest of the list is re-recorded from there.
+ *
+ * Brushes and pens are kept in tables and converted to graphics
+ * brushes and pens the first time they are replayed, instead of on
+ * every SetBrush and SetPen.
+ */
+class DisplayList
+{
+private:
+    /// The recorded operations
+    enum class Op : uint8_t
+    {
+        PushState, PopState, Translate, Rotate, Scale,
+        SetBrush, SetPen, DrawRectangle, DrawEllipse,
+        MoveToPoint, AddCurveToPoint, StrokePath,
+        DrawPolygon, DrawCylinder
+    };
+
+    /**
+     * One recorded command
+     */
+    struct Command
+    {
+        /// Operation
+        Op mOp = Op::PushState;
+        /// Index of the brush or pen the command uses
+        int mResource = -1;
+        /// Polygon or cylinder the command draws
+        const void *mObject = nullptr;
+        /// Parameters of the operation
+        double mParams[6] = {0};
+    };
+
+    /**
+     * A brush or pen and the graphics object it converts to
+     * @tparam T wxBrush or wxPen
+     * @tparam G wxGraphicsBrush or wxGraphicsPen
+     */
+    template<class T, class G>
+    struct Resource
+    {
+        /// The brush or pen that was recorded
+        T mObject;
+        /// The converted object, created when first replayed
+        G mGraphics;
+    };
+
+    /// The recorded commands
+    std::vector<Command> mCommands;
+
+    /// Index of the next command to record
+    size_t mPosition = 0;
+
+    /// Brushes used by the commands
+    std::vector<Resource<wxBrush, wxGraphicsBrush>> mBrushes;
+
+    /// Pens used by the commands
+    std::vector<Resource<wxPen, wxGraphicsPen>> mPens;
+
+    /// Renderer that created the converted brushes and pens
+    wxGraphicsRenderer *mRenderer = nullptr;
+
+    /// Path being built while replaying
+    wxGraphicsPath mPath;
+
+    /// Number of commands patched in place since the list was created
+    size_t mPatched = 0;
+
+    /// Number of commands appended since the list was created
+    size_t mAppended = 0;
+
+    Command &Record(Op op, int resource = -1, const void *object = nullptr);
+
+public:
+    DisplayList() {}
+
+    /// delete the copy constructor
+    DisplayList(const DisplayList&) = delete;
+
+    /// delete the copy assignment operator
+    DisplayList& operator=(const DisplayList&) = delete;
+
+    /**
+     * Start recording from the first command
+     */
+    void Begin() { mPosition = 0; }
+
+    void End();
+
+    void Replay(std::shared_ptr<wxGraphicsContext> graphics);
+
+    void Replay(std::shared_ptr<wxGraphicsContext> graphics, size_t begin, size_t end);
+
+    /**
+     * Get the index of the next command to record
+     * @return Number of commands recorded so far
+     */
+    size_t GetPosition() const { return mPosition; }
+
+    void PushState();
+    void PopState();
+    void Translate(double x, double y);
+    void Rotate(double angle);
+    void Scale(double x, double y);
+    void SetBrush(const wxBrush &brush);
+    void SetPen(const wxPen &pen);
+    void DrawRectangle(double x, double y, double width, double height);
+    void DrawEllipse(double x, double y, double width, double height);
+    void MoveToPoint(double x, double y);
+    void AddCurveToPoint(double cx1, double cy1, double cx2, double cy2, double x, double y);
+    void StrokePath();
+    void DrawPolygon(const cse335::Polygon &polygon, double x, double y, double rotation = 0);
+    void DrawCylinder(const cse335::Cylinder &cylinder, double x, double y, double rotation);
+
+    /**
+     * Get the number of recorded commands
+     * @return Number of commands
+     */
+    size_t GetSize() const { return mCommands.size(); }
+
+    /**
+     * Get the number of commands that were patched in place
+     * @return Number of patched commands since the list was created
+     */
+    size_t GetPatched() const { return mPatched; }
+
+    /**
+     * Get the number of commands that had to be appended
+     * @return Number of appended commands since the list was created
+     */
+    size_t GetAppended() const { return mAppended; }
+};
+
+
+#endif //DISPLAYLIST_H
@@ -0,0 +1,27 @@
+/**
+ * @file DriveTable.cpp
+ * @author Jaylon Sifuentes
+ */
+
+#include "pch.h"
+#include "DriveTable.h"
+#include "IRotationSink.h"
+
+/**
+ * Propagate a source rotation to every sink in the table.
+ * @param rotation Rotation of the source in turns
+ */
+void DriveTable::Propagate(double rotation)
+{
+    const size_t count = mRotations.size();
+    for (size_t i = 0; i < count; i++)
+    {
+        *mRotations[i] = rotation * mMultipliers[i];
+    }
+
+    const size_t listeners = mListeners.size();
+    for (size_t i = 0; i < listeners; i++)
+    {
+        mListeners[i]->UpdateRotation(rotation * mListenerMultipliers[i]);
+    }
+}
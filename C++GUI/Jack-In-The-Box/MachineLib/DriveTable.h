@@ -0,0 +1,75 @@
+/**
+ * @file DriveTable.h
+ * @author Jaylon Sifuentes
+ *
+ * Class that represents a compiled rotation drive graph.
+ */
+
+#ifndef DRIVETABLE_H
+#define DRIVETABLE_H
+
+#include <vector>
+
+class IRotationSink;
+
+/**
+ * A rotation drive graph flattened into a table.
+ *
+ * Every shaft, pulley and belt link below a rotation source is folded
+ * into a single multiplier per sink, so propagating a rotation is one
+ * linear pass over contiguous arrays. Sinks that react to rotation
+ * (playing notes, dropping the key) are kept in a short listener list
+ * and are still told through IRotationSink::UpdateRotation.
+ */
+class DriveTable
+{
+private:
+    /// Rotation storage of each linked sink, in drive order
+    std::vector<double*> mRotations;
+    /// Multiplier from the source rotation to each linked sink rotation
+    std::vector<double> mMultipliers;
+
+    /// Sinks that must be told about rotation changes, in drive order
+    std::vector<IRotationSink*> mListeners;
+    /// Multiplier from the source rotation to each listener rotation
+    std::vector<double> mListenerMultipliers;
+
+public:
+    /**
+     * Add a sink whose rotation is a fixed multiple of the source rotation
+     * @param rotation Rotation storage of the sink
+     * @param multiplier Multiplier from the source rotation
+     */
+    void AddRotation(double *rotation, double multiplier)
+    {
+        mRotations.push_back(rotation);
+        mMultipliers.push_back(multiplier);
+    }
+
+    /**
+     * Add a sink that must be told when its rotation changes
+     * @param sink Sink to tell
+     * @param multiplier Multiplier from the source rotation
+     */
+    void AddListener(IRotationSink *sink, double multiplier)
+    {
+        mListeners.push_back(sink);
+        mListenerMultipliers.push_back(multiplier);
+    }
+
+    void Propagate(double rotation);
+
+    /**
+     * Remove all entries from the table
+     */
+    void Clear()
+    {
+        mRotations.clear();
+        mMultipliers.clear();
+        mListeners.clear();
+        mListenerMultipliers.clear();
+    }
+};
+
+
+#endif //DRIVETABLE_H
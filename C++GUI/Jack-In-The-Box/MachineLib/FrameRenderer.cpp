@@ -0,0 +1,121 @@
+/**
+ * @file FrameRenderer.cpp
+ * @author Jaylon Sifuentes
+ */
+
+#include "pch.h"
+#include "FrameRenderer.h"
+#include "IMachineSystem.h"
+
+/**
+ * Constructor
+ * @param width Width of the rendered images in pixels
+ * @param height Height of the rendered images in pixels
+ */
+FrameRenderer::FrameRenderer(int width, int height) : mWidth(width), mHeight(height)
+{
+}
+
+/**
+ * Render a frame of a machine system
+ * @param system Machine system to render
+ * @param frame Frame to render
+ * @return Rendered image
+ */
+wxImage FrameRenderer::Render(IMachineSystem &system, int frame) const
+{
+    system.SetMachineFrame(frame);
+    return Draw(system);
+}
+
+/**
+ * Draw the current frame of a machine system
+ * @param system Machine system to draw
+ * @return Rendered image
+ */
+wxImage FrameRenderer::Draw(IMachineSystem &system) const
+{
+    wxImage image(mWidth, mHeight);
+    image.SetRGB(wxRect(0, 0, mWidth, mHeight), mBackground.Red(), mBackground.Green(), mBackground.Blue());
+
+    // The image is only updated once the graphics context is destroyed
+    {
+        std::shared_ptr<wxGraphicsContext> graphics(wxGraphicsContext::Create(image));
+        graphics->SetInterpolationQuality(wxINTERPOLATION_BEST);
+        system.DrawMachine(graphics);
+    }
+
+    return image;
+}
+
+/**
+ * Write an image to a stream as raw 8 bit RGBA pixels
+ * @param image Image to write
+ * @param stream Stream to write to
+ */
+void FrameRenderer::WriteRGBA(const wxImage &image, std::ostream &stream)
+{
+    const int pixels = image.GetWidth() * image.GetHeight();
+    const unsigned char *rgb = image.GetData();
+    const unsigned char *alpha = image.HasAlpha() ? image.GetAlpha() : nullptr;
+
+    std::vector<unsigned char> rgba(pixels * 4);
+    for (int i = 0; i < pixels; i++)
+    {
+        rgba[i * 4] = rgb[i * 3];
+        rgba[i * 4 + 1] = rgb[i * 3 + 1];
+        rgba[i * 4 + 2] = rgb[i * 3 + 2];
+        rgba[i * 4 + 3] = alpha != nullptr ? alpha[i] : 255;
+    }
+
+    stream.write(reinterpret_cast<const char *>(rgba.data()), rgba.size());
+}
+
+/**
+ * Compare an image against a reference image.
+ *
+ * A pixel differs if any color channel differs by more than the
+ * tolerance. The diff image shows the reference dimmed, with the
+ * differing pixels in red.
+ *
+ * @param image Image to compare
+ * @param reference Reference image. Must be the same size as the image.
+ * @param tolerance Largest allowed difference of a color channel, from 0 to 255
+ * @param diff Receives the diff image
+ * @return Number of pixels that differ
+ */
+int FrameRenderer::Compare(const wxImage &image, const wxImage &reference, int tolerance, wxImage &diff)
+{
+    const int width = image.GetWidth();
+    const int height = image.GetHeight();
+    const unsigned char *actual = image.GetData();
+    const unsigned char *expected = reference.GetData();
+
+    diff = wxImage(width, height);
+    unsigned char *marked = diff.GetData();
+
+    int differing = 0;
+    for (int i = 0; i < width * height * 3; i += 3)
+    {
+        bool differs = false;
+        for (int c = 0; c < 3; c++)
+        {
+            differs = differs || std::abs(actual[i + c] - expected[i + c]) > tolerance;
+        }
+
+        if (differs)
+        {
+            differing++;
+            marked[i] = 255;
+            marked[i + 1] = 0;
+            marked[i + 2] = 0;
+        }
+        else
+        {
+            unsigned char gray = (expected[i] + expected[i + 1] + expected[i + 2]) / 12;
+            marked[i] = marked[i + 1] = marked[i + 2] = gray;
+        }
+    }
+
+    return differing;
+}
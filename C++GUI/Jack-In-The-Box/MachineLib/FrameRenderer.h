@@ -0,0 +1,62 @@
+/**
+ * @file FrameRenderer.h
+ * @author Jaylon Sifuentes
+ *
+ * Class that renders machine frames into offscreen images.
+ */
+
+#ifndef FRAMERENDERER_H
+#define FRAMERENDERER_H
+
+#include <ostream>
+
+class IMachineSystem;
+
+/**
+ * Renders frames of a machine system into offscreen images.
+ *
+ * No window or display is needed, so this can be used to
+ * batch render frames on a headless system.
+ */
+class FrameRenderer
+{
+private:
+    /// Width of the rendered images in pixels
+    int mWidth;
+    /// Height of the rendered images in pixels
+    int mHeight;
+    /// Background color for the rendered images
+    wxColour mBackground = wxColour(255, 255, 255);
+
+public:
+    FrameRenderer(int width, int height);
+
+    /**
+     * Set the background color of the rendered images
+     * @param color Background color
+     */
+    void SetBackground(const wxColour &color) { mBackground = wxColour(color.Red(), color.Green(), color.Blue()); }
+
+    /**
+     * Get the width of the rendered images
+     * @return Width in pixels
+     */
+    int GetWidth() const { return mWidth; }
+
+    /**
+     * Get the height of the rendered images
+     * @return Height in pixels
+     */
+    int GetHeight() const { return mHeight; }
+
+    wxImage Render(IMachineSystem &system, int frame) const;
+
+    wxImage Draw(IMachineSystem &system) const;
+
+    static void WriteRGBA(const wxImage &image, std::ostream &stream);
+
+    static int Compare(const wxImage &image, const wxImage &reference, int tolerance, wxImage &diff);
+};
+
+
+#endif //FRAMERENDERER_H
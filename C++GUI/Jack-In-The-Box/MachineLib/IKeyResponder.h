@@ -23,8 +23,9 @@ public:
     /**
      * Triggered by cam when the key falls into the fall, which
      * notifies Box and Sparty's respective implementations.
+     * @param time Machine time in seconds at which the key dropped
      */
-    virtual void OnKeyDrop() = 0;
+    virtual void OnKeyDrop(double time) = 0;
 };
 
 
@@ -8,6 +8,9 @@
 #ifndef ROTATIONSINK_H
 #define ROTATIONSINK_H
 
+#include "DriveTable.h"
+
+class RotationSource;
 
 /**
  * An object of this class represents a rotation sink.
@@ -24,6 +27,35 @@ public:
      * @param rotation Rotation received from some source
      */
     virtual void UpdateRotation(double rotation) = 0;
+
+    /**
+     * Add this sink alone, not what it drives, to a compiled drive table.
+     * By default a sink is told about rotation changes through UpdateRotation.
+     * @param table Drive table to add to
+     * @param multiplier Multiplier from the table source rotation to this sink
+     */
+    virtual void AddToTable(DriveTable &table, double multiplier)
+    {
+        table.AddListener(this, multiplier);
+    }
+
+    /**
+     * Add this sink and everything it drives to a compiled drive table.
+     * @param table Drive table to add to
+     * @param multiplier Multiplier from the table source rotation to this sink
+     */
+    virtual void Compile(DriveTable &table, double multiplier)
+    {
+        AddToTable(table, multiplier);
+    }
+
+    /**
+     * Set the source that drives this sink.
+     * Sinks with a rotation source of their own pass it on, so changes
+     * to the graph below them reach the table compiled at the root.
+     * @param driver Source driving this sink
+     */
+    virtual void SetDriver(RotationSource *driver) {}
 };
 
 
@@ -0,0 +1,130 @@
+/**
+ * @file ImageCache.cpp
+ * @author Jaylon Sifuentes
+ */
+
+#include "pch.h"
+#include "ImageCache.h"
+#include "Tracer.h"
+
+using namespace cse335;
+
+/**
+ * Get the process wide cache
+ * @return The image cache
+ */
+ImageCache &ImageCache::Instance()
+{
+    static ImageCache cache;
+    return cache;
+}
+
+/**
+ * Get the decoded image for a file, loading it if it is not cached
+ * @param filename Image filename
+ * @return Decoded image or nullptr if the file could not be loaded
+ */
+std::shared_ptr<const wxImage> ImageCache::GetImage(const std::wstring &filename)
+{
+    auto &cache = Instance();
+    std::lock_guard<std::mutex> lock(cache.mMutex);
+
+    auto &entry = cache.mEntries[filename];
+    auto image = entry.mImage.lock();
+    if(image != nullptr)
+    {
+        return image;
+    }
+
+    // Prevent error popup from wxWidgets
+    wxLogNull logNo;
+    Tracer::Span span("ImageCache::Decode", "image");
+
+    auto decoded = std::make_unique<wxImage>();
+    if(!decoded->LoadFile(filename, wxBITMAP_TYPE_ANY))
+    {
+        cache.mEntries.erase(filename);
+        return nullptr;
+    }
+
+    // The entry and its bitmaps are erased when the last user releases the image
+    std::shared_ptr<const wxImage> loaded(decoded.release(), [filename](const wxImage *image) {
+        Release(filename);
+        delete image;
+    });
+
+    // Any bitmaps are from an image that has since been released
+    entry.mBitmaps.clear();
+    entry.mImage = loaded;
+    return loaded;
+}
+
+/**
+ * Erase the entry for an image file once its image has been released.
+ *
+ * The entry is kept if the file was loaded again in the meantime.
+ *
+ * @param filename Image filename
+ */
+void ImageCache::Release(const std::wstring &filename)
+{
+    auto &cache = Instance();
+    std::lock_guard<std::mutex> lock(cache.mMutex);
+
+    auto found = cache.mEntries.find(filename);
+    if(found != cache.mEntries.end() && found->second.mImage.expired())
+    {
+        cache.mEntries.erase(found);
+    }
+}
+
+/**
+ * Get the number of image files in the cache
+ * @return Number of cached image files
+ */
+size_t ImageCache::GetSize()
+{
+    auto &cache = Instance();
+    std::lock_guard<std::mutex> lock(cache.mMutex);
+    return cache.mEntries.size();
+}
+
+/**
+ * Get the graphics bitmap for a cached image file.
+ *
+ * The image must be in use (obtained from GetImage) when this is called.
+ *
+ * @param graphics Graphics context the bitmap will be drawn on
+ * @param filename Image filename
+ * @return Graphics bitmap, null if the image is not cached
+ */
+wxGraphicsBitmap ImageCache::GetBitmap(const std::shared_ptr<wxGraphicsContext> &graphics,
+                                       const std::wstring &filename)
+{
+    auto &cache = Instance();
+    std::lock_guard<std::mutex> lock(cache.mMutex);
+
+    auto found = cache.mEntries.find(filename);
+    if(found == cache.mEntries.end())
+    {
+        return wxGraphicsBitmap();
+    }
+
+    // Only the caller's reference keeps the image alive, so the cache
+    // never drops the last reference while it holds the lock
+    if(found->second.mImage.expired())
+    {
+        return wxGraphicsBitmap();
+    }
+    auto image = found->second.mImage.lock();
+
+    BitmapKey key(graphics->GetRenderer(), std::this_thread::get_id());
+    auto &bitmaps = found->second.mBitmaps;
+    auto bitmap = bitmaps.find(key);
+    if(bitmap == bitmaps.end())
+    {
+        bitmap = bitmaps.emplace(key, graphics->CreateBitmapFromImage(*image)).first;
+    }
+
+    return bitmap->second;
+}
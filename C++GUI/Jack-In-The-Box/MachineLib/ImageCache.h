@@ -0,0 +1,68 @@
+/**
+ * @file ImageCache.h
+ * @author Jaylon Sifuentes
+ *
+ * Process wide cache of decoded images.
+ */
+
+#ifndef IMAGECACHE_H
+#define IMAGECACHE_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace cse335
+{
+
+/**
+ * Process wide cache of decoded images keyed by file path.
+ *
+ * Every polygon that uses the same image file shares one immutable
+ * decoded image, and one graphics bitmap per renderer, so an image is
+ * decoded and uploaded only once. An image is released when the
+ * last polygon using it goes away.
+ *
+ * Graphics bitmaps are not safe to share between threads, so
+ * bitmaps are kept per thread.
+ */
+class ImageCache
+{
+private:
+    /// Key for a graphics bitmap: the renderer and the thread using it
+    typedef std::pair<wxGraphicsRenderer *, std::thread::id> BitmapKey;
+
+    /// A cached image file
+    struct Entry
+    {
+        /// The decoded image, while anything is using it
+        std::weak_ptr<const wxImage> mImage;
+        /// Graphics bitmaps created from the image
+        std::map<BitmapKey, wxGraphicsBitmap> mBitmaps;
+    };
+
+    /// The cached images indexed by file path
+    std::map<std::wstring, Entry> mEntries;
+
+    /// Protects the cache
+    std::mutex mMutex;
+
+    static ImageCache &Instance();
+
+    static void Release(const std::wstring &filename);
+
+public:
+    static std::shared_ptr<const wxImage> GetImage(const std::wstring &filename);
+
+    static wxGraphicsBitmap GetBitmap(const std::shared_ptr<wxGraphicsContext> &graphics,
+                                      const std::wstring &filename);
+
+    static size_t GetSize();
+};
+
+}
+
+#endif //IMAGECACHE_H
@@ -0,0 +1,75 @@
+/**
+ * @file LockFreeQueue.h
+ * @author Jaylon Sifuentes
+ *
+ * Lock-free single producer, single consumer queue.
+ */
+
+#ifndef LOCKFREEQUEUE_H
+#define LOCKFREEQUEUE_H
+
+#include <array>
+#include <atomic>
+
+/**
+ * Fixed size lock-free queue for passing items from
+ * one producer thread to one consumer thread.
+ *
+ * Neither side ever blocks. Push fails if the queue is full.
+ * @tparam T Item type
+ * @tparam Capacity Queue size. One slot is always left empty.
+ */
+template<class T, size_t Capacity>
+class LockFreeQueue
+{
+private:
+    /// The queued items
+    std::array<T, Capacity> mItems;
+
+    /// Index of the next item to pop. Only written by the consumer.
+    std::atomic<size_t> mHead{0};
+
+    /// Index of the next free slot. Only written by the producer.
+    std::atomic<size_t> mTail{0};
+
+public:
+    /**
+     * Add an item to the queue. Called by the producer.
+     * @param item Item to add
+     * @return false if the queue is full
+     */
+    bool Push(const T &item)
+    {
+        size_t tail = mTail.load(std::memory_order_relaxed);
+        size_t next = (tail + 1) % Capacity;
+        if (next == mHead.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        mItems[tail] = item;
+        mTail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Remove the oldest item from the queue. Called by the consumer.
+     * @param item Receives the item
+     * @return false if the queue is empty
+     */
+    bool Pop(T &item)
+    {
+        size_t head = mHead.load(std::memory_order_relaxed);
+        if (head == mTail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        item = mItems[head];
+        mHead.store((head + 1) % Capacity, std::memory_order_release);
+        return true;
+    }
+};
+
+
+#endif //LOCKFREEQUEUE_H
@@ -6,16 +6,71 @@
 #include "Machine.h"
 #include "Component.h"
 
-void Machine::Draw(std::shared_ptr<wxGraphicsContext> graphics)
+void Machine::Draw(std::shared_ptr<wxGraphicsContext> graphics) const
 {
-    for (auto component : mComponents)
+    ComponentProfiler::Activation activation(mProfiler);
+    if(!mRecorded || mRecordedTime != mStore.GetTime())
     {
-        component->DrawComponentBackground(graphics);
+        Tracer::Span span("Machine::Record", "draw");
+        mRanges.clear();
+        mDisplayList.Begin();
+        for (const auto &component : mComponents)
+        {
+            size_t begin = mDisplayList.GetPosition();
+            component->DrawComponentBackground(mDisplayList);
+            mRanges.push_back({component.get(), ComponentProfiler::Phase::DrawBackground, begin,
+                               mDisplayList.GetPosition()});
+        }
 
+        for(const auto &component : mComponents)
+        {
+            size_t begin = mDisplayList.GetPosition();
+            component->DrawComponentForeground(mDisplayList);
+            mRanges.push_back({component.get(), ComponentProfiler::Phase::DrawForeground, begin,
+                               mDisplayList.GetPosition()});
+        }
+        mDisplayList.End();
+
+        mRecorded = true;
+        mRecordedTime = mStore.GetTime();
+    }
+
+    if (mProfiler == nullptr && !Tracer::IsEnabled())
+    {
+        mDisplayList.Replay(graphics);
+        return;
+    }
+
+    // The drawing happens in the replay, so that is what is timed for each component
+    for (const auto &range : mRanges)
+    {
+        ComponentProfiler::Scope scope(*range.mComponent, range.mPhase);
+        mDisplayList.Replay(graphics, range.mBegin, range.mEnd);
+    }
+}
+
+/**
+ * Jump directly to a time.
+ *
+ * Every component is reset and told the target time first, so
+ * when the drive components evaluate their rotation from the time
+ * (Crank::Seek) any events they trigger downstream see consistent state.
+ * The cost is the same as a single step no matter how far we jump.
+ *
+ * @param time Time to seek to in seconds
+ */
+void Machine::Seek(double time)
+{
+    mStore.SetTime(time);
+    SetSeeking(true);
+    for(const auto &component : mComponents)
+    {
+        component->Reset();
     }
 
-    for(auto component : mComponents)
+    for(const auto &component : mComponents)
     {
-        component->DrawComponentForeground(graphics);
+        component->Seek(time);
     }
+    SetSeeking(false);
 }
@@ -7,12 +7,20 @@
 
 #ifndef MACHINE_H
 #define MACHINE_H
+#include <memory_resource>
 #include "Component.h"
+#include "ComponentStore.h"
+#include "ComponentProfiler.h"
+#include "DisplayList.h"
 
 
 class MachineSystem;
 class Component;
 
+/// Size of the first block of a machine's arena in bytes.
+/// Large enough for the built in machines to need only one block.
+constexpr size_t MachineArenaSize = 64 * 1024;
+
 /**
  * Objects of this class represent a machine.
  */
@@ -23,26 +31,86 @@ private:
     /// controlling this machine
     MachineSystem* mMachineSystem = nullptr;
 
+    /// Arena owning the memory of every component of this machine.
+    /// Declared before the components so it is released after them.
+    std::pmr::monotonic_buffer_resource mArena{MachineArenaSize};
+
     /// The components apart of this machine
-    std::vector<std::shared_ptr<Component>> mComponents;
+    std::pmr::vector<std::shared_ptr<Component>> mComponents{&mArena};
+
+    /// Per frame simulation state of the components
+    ComponentStore mStore{&mArena};
+
+    /// Profiler that times the component calls, or nullptr if profiling is disabled
+    ComponentProfiler *mProfiler = nullptr;
+
+    /// Drawing commands of the components, recorded by Draw
+    mutable DisplayList mDisplayList;
 
-    /// Time
-    double mTime = 0;
+    /// True once the display list has been recorded
+    mutable bool mRecorded = false;
+
+    /// Machine time the display list was recorded at
+    mutable double mRecordedTime = 0;
+
+    /**
+     * The commands one component draw call recorded
+     */
+    struct DrawRange
+    {
+        /// Component that recorded the commands
+        const Component *mComponent;
+        /// Draw call that recorded them
+        ComponentProfiler::Phase mPhase;
+        /// Index of the first command
+        size_t mBegin;
+        /// Index past the last command
+        size_t mEnd;
+    };
+
+    /// Range of the display list recorded by each component draw call
+    mutable std::vector<DrawRange> mRanges;
 
 public:
     /**
-    * Draw the machine at the currently specified location
+     * Create a component in this machine's arena.
+     *
+     * The component and its shared_ptr control block are bump allocated
+     * and the memory is released all at once when the machine is destroyed,
+     * so the component must not outlive the machine.
+     * @tparam T Component type to create
+     * @param args Arguments to the component constructor
+     * @return The new component
+     */
+    template<class T, class... Args>
+    std::shared_ptr<T> Create(Args&&... args)
+    {
+        return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(&mArena), std::forward<Args>(args)...);
+    }
+
+    /**
+    * Draw the machine at the currently specified location.
+    *
+    * The components record into a retained display list, which is
+    * then replayed. If the machine time has not changed since the
+    * last draw the list is replayed without recording again. While
+    * profiling or tracing, each component's commands are replayed
+    * and timed on their own.
     * @param graphics Graphics object to render to
     */
-    void Draw(std::shared_ptr<wxGraphicsContext> graphics);
+    void Draw(std::shared_ptr<wxGraphicsContext> graphics) const;
 
     /**
-     * Add components to machine
+     * Add components to machine.
+     * The component is bound to the machine's component store,
+     * so this must happen before any drive table is built.
      * @param component component to add
      */
     void AddComponent(std::shared_ptr<Component> component)
     {
+        component->Bind(mStore);
         mComponents.push_back(component);
+        mRecorded = false;
     }
 
     /**
@@ -60,12 +128,7 @@ public:
      */
     void SetTime(double time)
     {
-        mTime = time;
-
-        for(auto component : mComponents)
-        {
-            component->SetTime(time);
-        }
+        mStore.SetTime(time);
     }
 
     /**
@@ -74,10 +137,95 @@ public:
      */
     void Advance(double increase)
     {
-        mTime += increase;
-        for(auto component : mComponents)
+        ComponentProfiler::Activation activation(mProfiler);
+        mStore.Advance(increase);
+    }
+
+    /**
+     * Jump directly to a time without stepping through
+     * the frames in between.
+     * @param time Time to seek to in seconds
+     */
+    void Seek(double time);
+
+    /**
+     * Compile the drive graphs of this machine.
+     * Called once after a factory has built the machine.
+     */
+    void Compile()
+    {
+        for(const auto &component : mComponents)
+        {
+            component->Compile();
+        }
+    }
+
+    /**
+     * Set if the machine is seeking rather than playing
+     * @param seeking True while the machine is seeking
+     */
+    void SetSeeking(bool seeking)
+    {
+        for(const auto &component : mComponents)
+        {
+            component->SetSeeking(seeking);
+        }
+    }
+
+    /**
+     * Mute any sound the machine makes
+     * @param mute True to mute
+     */
+    void Mute(bool mute)
+    {
+        for(const auto &component : mComponents)
+        {
+            component->Mute(mute);
+        }
+    }
+
+    /**
+     * Set a recorder that receives every sound the machine makes
+     * @param recorder Recorder to use or nullptr to stop recording
+     */
+    void SetRecorder(AudioRecorder *recorder)
+    {
+        for(const auto &component : mComponents)
+        {
+            component->SetRecorder(recorder);
+        }
+    }
+
+    /**
+     * Set a profiler that times the calls to the components
+     * @param profiler Profiler to use or nullptr to disable profiling
+     */
+    void SetProfiler(ComponentProfiler *profiler) { mProfiler = profiler; }
+
+    /**
+     * Save the state of this machine and all of its components
+     * @param checkpoint Checkpoint to write the state to
+     */
+    void SaveState(Checkpoint &checkpoint)
+    {
+        checkpoint.Write(mStore.GetTime());
+        for(const auto &component : mComponents)
+        {
+            component->SaveState(checkpoint);
+        }
+    }
+
+    /**
+     * Restore the state of this machine and all of its components
+     * @param checkpoint Checkpoint to read the state from
+     */
+    void RestoreState(Checkpoint &checkpoint)
+    {
+        checkpoint.Rewind();
+        mStore.SetTime(checkpoint.Read());
+        for(const auto &component : mComponents)
         {
-            component->Advance(increase);
+            component->RestoreState(checkpoint);
         }
     }
 
@@ -87,8 +235,8 @@ public:
      */
     void Reset()
     {
-        mTime = 0;
-        for(auto component : mComponents)
+        mStore.SetTime(0);
+        for(const auto &component : mComponents)
         {
             component->Reset();
         }
@@ -98,7 +246,7 @@ public:
      * Get the time that has passed
      * @return time that has passed
      */
-    double GetTime(){return mTime;}
+    double GetTime(){return mStore.GetTime();}
 
 
 };
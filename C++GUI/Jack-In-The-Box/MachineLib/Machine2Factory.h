@@ -20,8 +20,6 @@ class Shap;
 class Machine2Factory
 {
 private:
-    /// Path to the images directory
-    std::wstring mImagesDir;
     /// Path to the resources directory
     std::wstring mResourcesDir;
 
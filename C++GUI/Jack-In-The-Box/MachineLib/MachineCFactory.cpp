@@ -7,18 +7,51 @@
 
 #include "pch.h"
 #include "MachineCFactory.h"
-#include "Machine.h"
-#include "Box.h"
-#include "Cam.h"
-#include "Crank.h"
-#include "Sparty.h"
-#include "Crank.h"
-#include "Pulley.h"
-#include "RotationSource.h"
-#include "Shaft.h"
+#include "StaticMachineFactory.h"
 
-/// The images directory in resources
-const std::wstring ImagesDirectory = L"/images";
+/// Index of each part of machine #1
+enum Machine1Part
+{
+    M1Box, M1Sparty, M1Crank,
+    M1Shaft1, M1Pulley1,
+    M1Shaft2, M1Pulley2, M1Pulley3,
+    M1Shaft3, M1Pulley4, M1Cam
+};
+
+/**
+ * The parts of machine #1, in the order they are added to the machine
+ *
+ * The upper right shaft and its pulley are driven by the crank. A belt
+ * takes the rotation down to the lower middle shaft, and a second belt
+ * up to the upper left shaft and the cam that releases Sparty.
+ */
+constexpr std::array<MachinePart, 11> Machine1Parts = {
+    BoxPart(250, 240),
+    SpartyPart(L"/sparty.png", 212, 260, 80, 15, false, 0),
+    CrankPart(),
+    ShaftPart(),
+    PulleyPart(40, M1Shaft1, ShaftSide::Left),
+    ShaftPart(8, 230, {-115, -65}),
+    PulleyPart(95, M1Shaft2, ShaftSide::Right),
+    PulleyPart(20, M1Shaft2, ShaftSide::Left),
+    ShaftPart(ShaftDiameter, 50, {-115, -185}),
+    PulleyPart(80, M1Shaft3, ShaftSide::Left),
+    CamPart(M1Shaft3, ShaftSide::Right),
+};
+
+/// The links between the parts of machine #1
+constexpr std::array<MachineLink, 10> Machine1Links = {
+    DriveLink(M1Crank, M1Shaft1),
+    DriveLink(M1Shaft1, M1Pulley1),
+    BeltLink(M1Pulley1, M1Pulley2),
+    DriveLink(M1Pulley2, M1Shaft2),
+    DriveLink(M1Shaft2, M1Pulley3),
+    DriveLink(M1Pulley4, M1Shaft3),
+    BeltLink(M1Pulley3, M1Pulley4),
+    DriveLink(M1Pulley3, M1Cam),
+    ResponderLink(M1Cam, M1Box),
+    ResponderLink(M1Cam, M1Sparty),
+};
 
 
 /**
@@ -27,7 +60,7 @@ const std::wstring ImagesDirectory = L"/images";
  */
 MachineCFactory::MachineCFactory(std::wstring resourcesDir)
 {
-    mImagesDir = resourcesDir + ImagesDirectory;
+    mResourcesDir = resourcesDir;
 }
 
 
@@ -37,93 +70,5 @@ MachineCFactory::MachineCFactory(std::wstring resourcesDir)
  */
 std::shared_ptr<Machine> MachineCFactory::Create()
 {
-    // The machine itself
-    auto machine = std::make_shared<Machine>();
-
-    /*
-     * The Box class constructor parameters are:
-     * @param imagesDir Directory containing the images
-     * @param boxSize Size of the box in pixels (just the box, not the lid)
-     * @param lidSize Size of the lid in pixels
-     */
-    auto box = std::make_shared<Box>(mImagesDir, 250, 240);
-
-    // This simulates the cam key drop so the box will immediately open
-    //box->KeyDrop();
-    machine->AddComponent(box);
-
-    /*
-     * The Sparty class constructor parameters are:
-     * @param image Image file to load
-     * @param size Size to draw Sparty (width and height)
-     * @param springLength How long the spring is when fully extended in pixels
-     * @param springWidth How wide the spring is in pixels
-     * @param numLinks How many links (loops) there are in the spring
-     */
-    auto sparty =
-        std::make_shared<Sparty>(mImagesDir + L"/sparty.png", 212, 260, 80, 15, false, 0);
-
-    machine->AddComponent(sparty);
-
-    /*
-     * Create the crank!
-     */
-    auto crank = std::make_shared<Crank>();
-    machine->AddComponent(crank);
-
-    /*
-     * Create the upper right shaft and add it as a sink to the crank.
-     */
-    auto shaft = std::make_shared<Shaft>();
-    machine->AddComponent(shaft);
-    crank->GetSource()->AddSink(shaft);
-
-    /*
-     * Create the first pulley, and add it as a sink to the upper right shaft.
-     */
-    auto pulley1 = std::make_shared<Pulley>(40, shaft->GetLeftCenter());
-    machine->AddComponent(pulley1);
-    shaft->GetSource()->AddSink(pulley1);
-
-    /*
-     * Create the second shaft (lower middle)
-     * and its connected pulley rot source. Connect this second pulley
-     * to the first.
-     */
-    auto shaft2 = std::make_shared<Shaft>(8, 230, wxPoint(-115, -65));
-    machine->AddComponent(shaft2);
-    auto pulley2 = std::make_shared<Pulley>(95, shaft2->GetRightCenter());
-    machine->AddComponent(pulley2);
-    pulley1->BeltTo(pulley2); // Connect the second pulley to the first.
-    pulley2->GetSource()->AddSink(shaft2); // Set the 2nd shaft's source to the 2nd pulley
-
-    /*
-     * Set the 3rd pulley (left of lower middle shaft) to be driven by the shaft.
-     */
-    auto pulley3 = std::make_shared<Pulley>(20, shaft2->GetLeftCenter());
-    // set 3rd pullys source to the 2nd shaft
-    machine->AddComponent(pulley3);
-    shaft2->GetSource()->AddSink(pulley3);
-
-    /*
-     * Create the upper left mechanisms.
-     */
-     auto shaft3 = std::make_shared<Shaft>(ShaftDiameter, 50, wxPoint(-115, -185));
-     machine->AddComponent(shaft3);
-     auto pulley4 = std::make_shared<Pulley>(80, shaft3->GetLeftCenter());
-     pulley4->GetSource()->AddSink(shaft3);
-     // Connect the 3rd pulley to the 4th
-     pulley3->BeltTo(pulley4);
-     machine->AddComponent(pulley4);
-
-     /* Create the cam connected to the upper left shaft.
-      * Add Box and Sparty to responders to Cam.
-      */
-     auto cam = std::make_shared<Cam>(mImagesDir,shaft3->GetRightCenter());
-     machine->AddComponent(cam);
-     pulley3->GetSource()->AddSink(cam);
-     cam->AddResponder(box);
-     cam->AddResponder(sparty);
-
-    return machine;
+    return StaticMachineFactory<Machine1Parts, Machine1Links>::Create(mResourcesDir);
 }
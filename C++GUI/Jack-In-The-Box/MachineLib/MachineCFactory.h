@@ -22,8 +22,8 @@ class Shape;
  */
 class MachineCFactory {
 private:
-    /// Path to the images directory
-    std::wstring mImagesDir;
+    /// Path to the resources directory
+    std::wstring mResourcesDir;
 
 public:
     MachineCFactory(std::wstring resourcesDir);
@@ -0,0 +1,402 @@
+/**
+ * @file MachineDefinition.h
+ * @author Jaylon Sifuentes
+ *
+ * Compile time machine definitions.
+ */
+
+#ifndef MACHINEDEFINITION_H
+#define MACHINEDEFINITION_H
+
+#include <array>
+#include "Shaft.h"
+
+/// Types of component in a machine definition
+enum class PartType { Box, Sparty, Crank, Shaft, Pulley, Cam, MusicBox };
+
+/// Types of link between the parts of a machine definition
+enum class LinkType { Drive, Belt, Responder };
+
+/// End of a shaft a part is placed on
+enum class ShaftSide { Left, Right };
+
+/// A location in a machine definition
+struct PartPoint
+{
+    /// X location in pixels
+    int mX = 0;
+    /// Y location in pixels
+    int mY = 0;
+};
+
+/**
+ * A component in a machine definition.
+ * Made with the part functions below.
+ */
+struct MachinePart
+{
+    /// Component type
+    PartType mType = PartType::Box;
+    /// Location, unless the part is placed on a shaft
+    PartPoint mLocation;
+    /// Index of the shaft the part is placed on or -1
+    int mAt = -1;
+    /// End of the shaft the part is placed on
+    ShaftSide mSide = ShaftSide::Left;
+    /// Shaft or pulley diameter
+    int mDiameter = 0;
+    /// Shaft length
+    int mLength = 0;
+    /// Box size
+    int mBoxSize = 0;
+    /// Box lid size
+    int mLidSize = 0;
+    /// Sparty image in the images directory or music box song in the resources directory
+    const wchar_t *mFile = L"";
+    /// Sparty size
+    int mSize = 0;
+    /// Sparty spring length
+    int mSpringLength = 0;
+    /// Sparty spring width
+    int mSpringWidth = 0;
+    /// Sparty spring links
+    int mLinks = 0;
+    /// If Sparty bounces
+    bool mBouncy = false;
+    /// Sparty spring X offset
+    int mSpringX = 0;
+};
+
+/// A link between two parts of a machine definition, by index
+struct MachineLink
+{
+    /// Link type
+    LinkType mType;
+    /// Part the link is from
+    int mFrom;
+    /// Part the link is to
+    int mTo;
+};
+
+/**
+ * A box
+ * @param boxSize Size of the box in pixels (just the box, not the lid)
+ * @param lidSize Size of the lid in pixels
+ * @return Part definition
+ */
+constexpr MachinePart BoxPart(int boxSize, int lidSize)
+{
+    MachinePart part;
+    part.mType = PartType::Box;
+    part.mBoxSize = boxSize;
+    part.mLidSize = lidSize;
+    return part;
+}
+
+/**
+ * A Sparty on a spring
+ * @param image Image file in the images directory
+ * @param size Size to draw Sparty (width and height)
+ * @param springLength How long the spring is when fully extended in pixels
+ * @param springWidth How wide the spring is in pixels
+ * @param links How many links (loops) there are in the spring
+ * @param bouncy If Sparty bounces
+ * @param springX Spring X offset
+ * @return Part definition
+ */
+constexpr MachinePart SpartyPart(const wchar_t *image, int size, int springLength, int springWidth, int links,
+                                 bool bouncy, int springX)
+{
+    MachinePart part;
+    part.mType = PartType::Sparty;
+    part.mFile = image;
+    part.mSize = size;
+    part.mSpringLength = springLength;
+    part.mSpringWidth = springWidth;
+    part.mLinks = links;
+    part.mBouncy = bouncy;
+    part.mSpringX = springX;
+    return part;
+}
+
+/**
+ * A crank
+ * @param location Crank location
+ * @return Part definition
+ */
+constexpr MachinePart CrankPart(PartPoint location = {0, 0})
+{
+    MachinePart part;
+    part.mType = PartType::Crank;
+    part.mLocation = location;
+    return part;
+}
+
+/**
+ * A shaft
+ * @param diameter Shaft diameter
+ * @param length Shaft length in pixels
+ * @param location Shaft location
+ * @return Part definition
+ */
+constexpr MachinePart ShaftPart(int diameter = ShaftDiameter, int length = ShaftLength,
+                                PartPoint location = {ShaftDefaultX, ShaftDefaultY})
+{
+    MachinePart part;
+    part.mType = PartType::Shaft;
+    part.mDiameter = diameter;
+    part.mLength = length;
+    part.mLocation = location;
+    return part;
+}
+
+/**
+ * A pulley placed on the end of a shaft
+ * @param diameter Pulley diameter
+ * @param shaft Index of the shaft
+ * @param side End of the shaft
+ * @return Part definition
+ */
+constexpr MachinePart PulleyPart(int diameter, int shaft, ShaftSide side)
+{
+    MachinePart part;
+    part.mType = PartType::Pulley;
+    part.mDiameter = diameter;
+    part.mAt = shaft;
+    part.mSide = side;
+    return part;
+}
+
+/**
+ * A cam placed on the end of a shaft
+ * @param shaft Index of the shaft
+ * @param side End of the shaft
+ * @return Part definition
+ */
+constexpr MachinePart CamPart(int shaft, ShaftSide side)
+{
+    MachinePart part;
+    part.mType = PartType::Cam;
+    part.mAt = shaft;
+    part.mSide = side;
+    return part;
+}
+
+/**
+ * A music box
+ * @param song Song file in the resources directory
+ * @return Part definition
+ */
+constexpr MachinePart MusicBoxPart(const wchar_t *song)
+{
+    MachinePart part;
+    part.mType = PartType::MusicBox;
+    part.mFile = song;
+    return part;
+}
+
+/**
+ * Rotation from one part drives another
+ * @param source Driving part
+ * @param sink Driven part
+ * @return Link definition
+ */
+constexpr MachineLink DriveLink(int source, int sink)
+{
+    return {LinkType::Drive, source, sink};
+}
+
+/**
+ * A belt from one pulley drives another
+ * @param from Driving pulley
+ * @param to Driven pulley
+ * @return Link definition
+ */
+constexpr MachineLink BeltLink(int from, int to)
+{
+    return {LinkType::Belt, from, to};
+}
+
+/**
+ * A part responds to a cam key drop
+ * @param cam The cam
+ * @param responder The responding box or Sparty
+ * @return Link definition
+ */
+constexpr MachineLink ResponderLink(int cam, int responder)
+{
+    return {LinkType::Responder, cam, responder};
+}
+
+/**
+ * Check that a machine definition is consistent
+ * @param parts Parts of the machine
+ * @param links Links between the parts
+ * @return true if the definition is valid
+ */
+template<size_t P, size_t L>
+constexpr bool ValidMachine(const std::array<MachinePart, P> &parts, const std::array<MachineLink, L> &links)
+{
+    for (size_t i = 0; i < P; i++)
+    {
+        auto &part = parts[i];
+        bool placed = part.mType == PartType::Pulley || part.mType == PartType::Cam;
+        if (placed != (part.mAt >= 0))
+        {
+            return false;
+        }
+        if (placed && (part.mAt >= (int)i || parts[part.mAt].mType != PartType::Shaft))
+        {
+            return false;
+        }
+    }
+
+    std::array<int, P> drivers{};
+    std::array<bool, P> belted{};
+    for (auto &link : links)
+    {
+        if (link.mFrom < 0 || link.mFrom >= (int)P || link.mTo < 0 || link.mTo >= (int)P)
+        {
+            return false;
+        }
+
+        auto from = parts[link.mFrom].mType;
+        auto to = parts[link.mTo].mType;
+        switch (link.mType)
+        {
+        case LinkType::Drive:
+            if ((from != PartType::Crank && from != PartType::Shaft && from != PartType::Pulley) ||
+                (to != PartType::Shaft && to != PartType::Pulley && to != PartType::Cam && to != PartType::MusicBox))
+            {
+                return false;
+            }
+            break;
+
+        case LinkType::Belt:
+            if (from != PartType::Pulley || to != PartType::Pulley || belted[link.mFrom])
+            {
+                return false;
+            }
+            belted[link.mFrom] = true;
+            break;
+
+        case LinkType::Responder:
+            if (from != PartType::Cam || (to != PartType::Box && to != PartType::Sparty))
+            {
+                return false;
+            }
+            break;
+        }
+
+        // Each part is driven by at most one other
+        if (link.mType != LinkType::Responder && drivers[link.mTo]++ > 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Resolve the location of every part. Parts placed on a shaft
+ * get the location of that end of the shaft.
+ * @param parts Parts of the machine
+ * @return Location of each part
+ */
+template<size_t P>
+constexpr std::array<PartPoint, P> PartLocations(const std::array<MachinePart, P> &parts)
+{
+    std::array<PartPoint, P> locations{};
+    for (size_t i = 0; i < P; i++)
+    {
+        locations[i] = parts[i].mLocation;
+        if (parts[i].mAt >= 0)
+        {
+            auto &shaft = parts[parts[i].mAt];
+            int x = parts[i].mSide == ShaftSide::Left ? ShaftLeftCenterX : shaft.mLength - ShaftRightCenterX;
+            locations[i] = {shaft.mLocation.mX + x, shaft.mLocation.mY - ShaftCenterY};
+        }
+    }
+
+    return locations;
+}
+
+/**
+ * The drive tables of a machine, worked out ahead of time
+ */
+template<size_t P>
+struct DrivePlan
+{
+    /// Part of each table entry, in drive order
+    std::array<int, P> mPart{};
+    /// Crank at the root of each table entry
+    std::array<int, P> mCrank{};
+    /// Multiplier from the crank's source rotation to each table entry
+    std::array<double, P> mMultiplier{};
+    /// Number of table entries
+    size_t mCount = 0;
+};
+
+/**
+ * Add everything a part drives to a drive plan, depth first in
+ * the same order RotationSource::Compile walks the graph
+ * @param parts Parts of the machine
+ * @param links Links between the parts
+ * @param plan Plan to add to
+ * @param part Driving part
+ * @param crank Crank at the root
+ * @param multiplier Multiplier from the crank's source rotation to the part
+ */
+template<size_t P, size_t L>
+constexpr void PlanDrive(const std::array<MachinePart, P> &parts, const std::array<MachineLink, L> &links,
+                         DrivePlan<P> &plan, int part, int crank, double multiplier)
+{
+    for (auto type : {LinkType::Drive, LinkType::Belt})
+    {
+        for (auto &link : links)
+        {
+            if (link.mType != type || link.mFrom != part)
+            {
+                continue;
+            }
+
+            // Same integer radii as Pulley::BeltRatio
+            double ratio = 1;
+            if (type == LinkType::Belt)
+            {
+                ratio = (double)(parts[link.mFrom].mDiameter / 2) / (parts[link.mTo].mDiameter / 2);
+            }
+
+            plan.mPart[plan.mCount] = link.mTo;
+            plan.mCrank[plan.mCount] = crank;
+            plan.mMultiplier[plan.mCount] = multiplier * ratio;
+            plan.mCount++;
+            PlanDrive(parts, links, plan, link.mTo, crank, multiplier * ratio);
+        }
+    }
+}
+
+/**
+ * Work out the drive table of every crank in a machine
+ * @param parts Parts of the machine
+ * @param links Links between the parts
+ * @return Drive plan
+ */
+template<size_t P, size_t L>
+constexpr DrivePlan<P> PlanDrives(const std::array<MachinePart, P> &parts, const std::array<MachineLink, L> &links)
+{
+    DrivePlan<P> plan{};
+    for (size_t i = 0; i < P; i++)
+    {
+        if (parts[i].mType == PartType::Crank)
+        {
+            PlanDrive(parts, links, plan, (int)i, (int)i, 1);
+        }
+    }
+
+    return plan;
+}
+
+
+#endif //MACHINEDEFINITION_H
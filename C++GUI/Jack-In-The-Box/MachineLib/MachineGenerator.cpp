@@ -0,0 +1,130 @@
+/**
+ * @file MachineGenerator.cpp
+ * @author Jaylon Sifuentes
+ */
+
+#include "pch.h"
+#include <random>
+#include "MachineGenerator.h"
+#include "Machine.h"
+#include "Box.h"
+#include "Sparty.h"
+#include "Crank.h"
+#include "Shaft.h"
+#include "Pulley.h"
+#include "Cam.h"
+
+/// The images directory in resources
+const std::wstring ImagesDirectory = L"/images";
+
+/// Length of a generated shaft in pixels
+const int GeneratedShaftLength = 40;
+
+/// Shafts in each row of the layout
+const int LayoutColumns = 24;
+
+/// Horizontal distance between shafts in the layout
+const int LayoutSpacingX = 50;
+
+/// Vertical distance between shafts in the layout
+const int LayoutSpacingY = 45;
+
+/// Top left shaft location of the layout
+const wxPoint LayoutOrigin = wxPoint(-600, -500);
+
+/// Pulley diameters to choose from. Even so belt ratios are exact.
+const int PulleyDiameters[] = {20, 40, 60, 80};
+
+/// Chance that a shaft with room below it grows a belt rather than a cam
+const double BranchChance = 0.6;
+
+/// Components every machine has: the box, Sparty, crank and root shaft
+const int FixedComponents = 4;
+
+/// Components in a belt branch: the driving pulley, driven pulley and new shaft
+const int BranchComponents = 3;
+
+/**
+ * Constructor
+ * @param resourcesDir Path to the resources directory
+ */
+MachineGenerator::MachineGenerator(std::wstring resourcesDir) : mResourcesDir(resourcesDir)
+{
+}
+
+/**
+ * Generate a machine
+ * @return Generated machine
+ */
+std::shared_ptr<Machine> MachineGenerator::Create()
+{
+    std::mt19937 random(mSeed);
+    std::uniform_real_distribution<double> chance(0, 1);
+    std::uniform_int_distribution<int> diameter(0, (int)std::size(PulleyDiameters) - 1);
+
+    auto machine = std::make_shared<Machine>();
+    std::wstring imagesDir = mResourcesDir + ImagesDirectory;
+
+    auto box = machine->Create<Box>(imagesDir, 250, 240);
+    machine->AddComponent(box);
+
+    auto sparty = machine->Create<Sparty>(imagesDir + L"/sparty.png", 212, 260, 80, 15, false, 0);
+    machine->AddComponent(sparty);
+
+    auto crank = machine->Create<Crank>();
+    machine->AddComponent(crank);
+
+    // Shafts that can still drive something, with their depth
+    std::vector<std::pair<std::shared_ptr<Shaft>, int>> shafts;
+    int shaftCount = 0;
+    auto addShaft = [&](int depth) {
+        wxPoint location(LayoutOrigin.x + (shaftCount % LayoutColumns) * LayoutSpacingX,
+                         LayoutOrigin.y + (shaftCount / LayoutColumns) * LayoutSpacingY);
+        shaftCount++;
+
+        auto shaft = machine->Create<Shaft>(ShaftDiameter, GeneratedShaftLength, location);
+        machine->AddComponent(shaft);
+        shafts.emplace_back(shaft, depth);
+        return shaft;
+    };
+
+    crank->GetSource()->AddSink(addShaft(1));
+
+    std::shared_ptr<Cam> firstCam;
+    for (int count = FixedComponents; count < mComponents; )
+    {
+        std::uniform_int_distribution<size_t> pick(0, shafts.size() - 1);
+        auto [shaft, depth] = shafts[pick(random)];
+
+        if (depth < mDepth && count + BranchComponents <= mComponents && chance(random) < BranchChance)
+        {
+            auto driver = machine->Create<Pulley>(PulleyDiameters[diameter(random)], shaft->GetRightCenter());
+            machine->AddComponent(driver);
+            shaft->GetSource()->AddSink(driver);
+
+            auto child = addShaft(depth + 1);
+            auto driven = machine->Create<Pulley>(PulleyDiameters[diameter(random)], child->GetLeftCenter());
+            machine->AddComponent(driven);
+            driver->BeltTo(driven);
+            driven->GetSource()->AddSink(child);
+
+            count += BranchComponents;
+        }
+        else
+        {
+            auto cam = machine->Create<Cam>(imagesDir, shaft->GetRightCenter());
+            machine->AddComponent(cam);
+            shaft->GetSource()->AddSink(cam);
+            if (firstCam == nullptr)
+            {
+                firstCam = cam;
+                cam->AddResponder(box);
+                cam->AddResponder(sparty);
+            }
+
+            count++;
+        }
+    }
+
+    return machine;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file MachineGenerator.h
+ * @author Jaylon Sifuentes
+ *
+ * Generates random machines for stress testing.
+ */
+
+#ifndef MACHINEGENERATOR_H
+#define MACHINEGENERATOR_H
+
+#include <memory>
+#include <string>
+
+class Machine;
+
+/**
+ * Generates random machines with large drive trees.
+ *
+ * A crank turns a root shaft. Every shaft either drives cams or
+ * drives a pulley belted to a pulley on a new shaft one level deeper,
+ * until the machine has the requested number of components. A box and
+ * Sparty respond to the first cam. The same seed always generates the
+ * same machine.
+ */
+class MachineGenerator
+{
+private:
+    /// Path to the resources directory
+    std::wstring mResourcesDir;
+
+    /// Number of components to generate
+    int mComponents = 1000;
+
+    /// Maximum number of shafts from the crank to any leaf
+    int mDepth = 8;
+
+    /// Seed for the random number generator
+    unsigned mSeed = 1;
+
+public:
+    MachineGenerator(std::wstring resourcesDir);
+
+    /**
+     * Set the number of components to generate.
+     * Machines always have at least the crank, root shaft, box and Sparty.
+     * @param components Number of components
+     */
+    void SetComponentCount(int components) { mComponents = components; }
+
+    /**
+     * Set the maximum depth of the drive tree
+     * @param depth Maximum number of shafts from the crank to any leaf
+     */
+    void SetDepth(int depth) { mDepth = depth; }
+
+    /**
+     * Set the seed for the random number generator
+     * @param seed Seed
+     */
+    void SetSeed(unsigned seed) { mSeed = seed; }
+
+    std::shared_ptr<Machine> Create();
+};
+
+
+#endif //MACHINEGENERATOR_H
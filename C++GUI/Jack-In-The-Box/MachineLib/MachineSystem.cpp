@@ -4,10 +4,16 @@
  */
 
 #include "pch.h"
+#include <wx/filefn.h>
 #include "MachineSystem.h"
 #include "Machine.h"
 #include "Machine2Factory.h"
 #include "MachineCFactory.h"
+#include "MachineXmlFactory.h"
+#include "Tracer.h"
+
+/// The machine descriptions directory in resources
+const std::wstring MachinesDirectory = L"/machines/";
 
 MachineSystem::MachineSystem(std::wstring directory) : mResourcesDirectory(directory)
 {
@@ -43,60 +49,238 @@ void MachineSystem::Reset()
     mFrameRate = 0;
     mTime = 0;
     mMachine->Reset();
+    mCheckpoints.clear();
 }
 
 
 void MachineSystem::SetMachineFrame(int frame)
 {
-
-    while (mCurrentFrame < frame)
+    Tracer::Span span("MachineSystem::SetMachineFrame", "frame");
+    if (frame == mCurrentFrame + 1)
     {
+        // Playing forward, step the machine so notes are played
         mCurrentFrame++;
         mTime = mCurrentFrame / mFrameRate;
 
         mMachine->Advance(1.0 / mFrameRate);
         mMachine->SetTime(mTime);
     }
+    else if (frame != mCurrentFrame && !RestoreCheckpoint(frame))
+    {
+        // No checkpoint close enough. Evaluate the machine directly at the new time.
+        mCurrentFrame = frame;
+        mTime = mCurrentFrame / mFrameRate;
+        mMachine->Seek(mTime);
+    }
+
+    SaveCheckpoint();
+}
+
+/**
+ * Save a checkpoint if the current frame is on a checkpoint boundary
+ * and we do not already have one for it.
+ */
+void MachineSystem::SaveCheckpoint()
+{
+    int frame = (int)mCurrentFrame;
+    if (mCheckpointInterval <= 0 || frame % mCheckpointInterval != 0 || mCheckpoints.count(frame) > 0)
+    {
+        return;
+    }
+
+    mMachine->SaveState(mCheckpoints[frame]);
+}
 
-    while (mCurrentFrame > frame)
+/**
+ * Move to a frame by restoring the nearest earlier checkpoint and
+ * stepping forward from it. Stepping is silent, so notes are
+ * not replayed, and one-shot events like the key drop are undone
+ * when moving backwards.
+ * @param frame Frame to move to
+ * @return true if a checkpoint within one interval of the frame was found
+ */
+bool MachineSystem::RestoreCheckpoint(int frame)
+{
+    auto checkpoint = mCheckpoints.upper_bound(frame);
+    if (checkpoint == mCheckpoints.begin())
     {
-        mCurrentFrame--;
+        return false;
+    }
+
+    checkpoint--;
+    if (frame - checkpoint->first > mCheckpointInterval)
+    {
+        return false;
+    }
+
+    mMachine->RestoreState(checkpoint->second);
+    mCurrentFrame = checkpoint->first;
+
+    mMachine->SetSeeking(true);
+    while (mCurrentFrame < frame)
+    {
+        mCurrentFrame++;
         mTime = mCurrentFrame / mFrameRate;
-        mMachine->Advance(-1.0 / mFrameRate);
+
+        mMachine->Advance(1.0 / mFrameRate);
         mMachine->SetTime(mTime);
     }
+    mMachine->SetSeeking(false);
+
+    mTime = mCurrentFrame / mFrameRate;
+    return true;
 }
 
 void MachineSystem::SetFrameRate(double rate)
 {
+    if (rate != mFrameRate)
+    {
+        // Checkpoints are stored by frame, so they are only valid for one frame rate
+        mCheckpoints.clear();
+    }
     mFrameRate = rate;
 }
 
+void MachineSystem::Mute(bool mute)
+{
+    mMuted = mute;
+    mMachine->Mute(mute);
+}
 
-void MachineSystem::ChooseMachine(int machine)
+void MachineSystem::SetRecorder(AudioRecorder *recorder)
 {
-    if(mMachine != nullptr)
+    mRecorder = recorder;
+    mMachine->SetRecorder(recorder);
+}
+
+void MachineSystem::SetProfiling(bool enable)
+{
+    if (enable && mProfiler == nullptr)
+    {
+        mProfiler = std::make_unique<ComponentProfiler>();
+    }
+    else if (!enable)
     {
-        Reset();
+        mProfiler.reset();
     }
 
-    if (machine == 1)
+    mMachine->SetProfiler(mProfiler.get());
+}
+
+void MachineSystem::SetCheckpointInterval(int frames)
+{
+    mCheckpointInterval = frames;
+    mCheckpoints.clear();
+}
+
+
+/**
+ * Build a machine from its description in the resources
+ * machines directory, or with its factory if it has none
+ * @param machine Machine number
+ * @return Built machine or nullptr if there is no such machine
+ */
+std::shared_ptr<Machine> MachineSystem::CreateMachine(int machine)
+{
+    Tracer::Span span("MachineSystem::CreateMachine", "build");
+    std::shared_ptr<Machine> created;
+
+    // A machine description deployed in the resources takes the place of the built in machine
+    wxString description = wxString::Format(L"%smachine%d.xml", mResourcesDirectory + MachinesDirectory, machine);
+    if (wxFileExists(description))
+    {
+        MachineXmlFactory xmlFactory(mResourcesDirectory);
+        if (xmlFactory.Load(description.ToStdWstring()))
+        {
+            created = xmlFactory.Create();
+        }
+        else
+        {
+            wxLogWarning(L"Invalid machine description %s, %s", description, xmlFactory.GetError());
+        }
+    }
+
+    if (created == nullptr && machine == 1)
     {
 
         MachineCFactory tempFactory(mResourcesDirectory);
-        mMachine = tempFactory.Create();
-        mMachine->SetMachineSystem(this);
-        mMachineNumber = machine;
+        created = tempFactory.Create();
     }
-    if(machine == 2)
+    if(created == nullptr && machine == 2)
     {
 
         Machine2Factory tempFactory2(mResourcesDirectory);
-        mMachine = tempFactory2.Create();
-        mMachine->SetMachineSystem(this);
-        mMachineNumber = machine;
+        created = tempFactory2.Create();
+    }
+
+    if (created != nullptr)
+    {
+        created->SetMachineSystem(this);
+        created->Compile();
+    }
+
+    return created;
+}
+
+/**
+ * Set the machine number.
+ *
+ * Machines are only built the first time they are chosen. After that
+ * they are kept in a cache, so switching between machines is instant.
+ * The machine being left is reset unless machine state is preserved.
+ *
+ * @param machine An integer number. Each number makes a different machine
+ */
+void MachineSystem::ChooseMachine(int machine)
+{
+    auto chosen = mMachines.find(machine);
+    if (chosen == mMachines.end())
+    {
+        auto created = CreateMachine(machine);
+        if (created == nullptr)
+        {
+            return;
+        }
+
+        chosen = mMachines.emplace(machine, CachedMachine()).first;
+        chosen->second.mMachine = created;
+    }
+
+    if(mMachine != nullptr)
+    {
+        if (!mPreserveMachineState)
+        {
+            Reset();
+        }
+
+        // Only the current machine is recorded and profiled
+        mMachine->SetRecorder(nullptr);
+        mMachine->SetProfiler(nullptr);
+
+        // Remember the state this machine is left in
+        auto &left = mMachines[mMachineNumber];
+        left.mCurrentFrame = mCurrentFrame;
+        left.mTime = mTime;
+        left.mFrameRate = mFrameRate;
+        left.mCheckpoints = std::move(mCheckpoints);
+    }
+
+    auto &entry = chosen->second;
+    mMachine = entry.mMachine;
+    mMachineNumber = machine;
+    mCurrentFrame = entry.mCurrentFrame;
+    mTime = entry.mTime;
+    mCheckpoints = std::move(entry.mCheckpoints);
+    if (entry.mFrameRate != mFrameRate)
+    {
+        // Checkpoints are stored by frame, so they are only valid for one frame rate
+        mCheckpoints.clear();
     }
 
+    mMachine->Mute(mMuted);
+    mMachine->SetRecorder(mRecorder);
+    mMachine->SetProfiler(mProfiler.get());
+    SaveCheckpoint();
 }
 
 int MachineSystem::GetMachineNumber()
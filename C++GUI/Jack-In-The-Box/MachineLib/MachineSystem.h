@@ -7,10 +7,14 @@
 
 #ifndef MACHINESYSTEM_H
 #define MACHINESYSTEM_H
+#include <map>
 #include "IMachineSystem.h"
+#include "Checkpoint.h"
+#include "ComponentProfiler.h"
 
 
 class Machine;
+class AudioRecorder;
 
 /**
  * Objects of this class represent a machine system, which are derived from the IMachineSystem interface.
@@ -24,7 +28,7 @@ private:
     std::shared_ptr<Machine> mMachine;
 
     /// Number of currently selected machine
-    int mMachineNumber;
+    int mMachineNumber = 0;
 
     /// Resources directory. Must know since invoking factories
     std::wstring mResourcesDirectory;
@@ -37,6 +41,45 @@ private:
     double mCurrentFrame = 0;
     /// Flag
     int mFlag = 0;
+    /// If the machine sound is muted
+    bool mMuted = false;
+    /// Recorder that receives the machine sound, if any
+    AudioRecorder *mRecorder = nullptr;
+    /// Profiler timing the component calls, or nullptr if profiling is disabled
+    std::unique_ptr<ComponentProfiler> mProfiler;
+
+    /// Number of frames between checkpoints
+    int mCheckpointInterval = 30;
+    /// Machine state checkpoints indexed by frame
+    std::map<int, Checkpoint> mCheckpoints;
+
+    void SaveCheckpoint();
+    bool RestoreCheckpoint(int frame);
+
+    /**
+     * A machine that has been built and the state it was left in
+     */
+    struct CachedMachine
+    {
+        /// The machine
+        std::shared_ptr<Machine> mMachine;
+        /// Frame the machine was left at
+        double mCurrentFrame = 0;
+        /// Time the machine was left at
+        double mTime = 0;
+        /// Frame rate the checkpoints were saved at
+        double mFrameRate = 0;
+        /// Checkpoints for the machine
+        std::map<int, Checkpoint> mCheckpoints;
+    };
+
+    /// Machines that have been built, indexed by machine number
+    std::map<int, CachedMachine> mMachines;
+
+    /// If machines keep their state when switching away from them
+    bool mPreserveMachineState = false;
+
+    std::shared_ptr<Machine> CreateMachine(int machine);
 
 public:
     /**
@@ -79,6 +122,47 @@ public:
     */
     void SetFrameRate(double rate) override;
 
+    /**
+     * Set how often the machine state is checkpointed.
+     * A seek never has to step more than this many frames.
+     * @param frames Number of frames between checkpoints
+     */
+    void SetCheckpointInterval(int frames);
+
+    /**
+     * Set if machines keep their state when switching to another machine.
+     * Otherwise a machine is reset when it is switched away from.
+     * @param preserve True to preserve machine state
+     */
+    void SetPreserveMachineState(bool preserve) { mPreserveMachineState = preserve; }
+
+    /**
+     * Mute any sound the machines make
+     * @param mute True to mute
+     */
+    void Mute(bool mute);
+
+    /**
+     * Record the sound the machines make. The recorder
+     * receives every sound even when the machines are muted.
+     * @param recorder Recorder to use or nullptr to stop recording
+     */
+    void SetRecorder(AudioRecorder *recorder);
+
+    /**
+     * Enable or disable timing the calls to the components.
+     * Disabling profiling discards the timings.
+     * @param enable True to enable profiling
+     */
+    void SetProfiling(bool enable);
+
+    /**
+     * Get the profiler timing the component calls of the machines.
+     * Timings are aggregated by component type over every machine.
+     * @return Profiler or nullptr if profiling is disabled
+     */
+    const ComponentProfiler *GetProfiler() const { return mProfiler.get(); }
+
 
     /**
     * Set the machine number
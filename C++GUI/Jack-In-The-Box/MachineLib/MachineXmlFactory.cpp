@@ -0,0 +1,423 @@
+/**
+ * @file MachineXmlFactory.cpp
+ * @author Jaylon Sifuentes
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include <set>
+#include <wx/xml/xml.h>
+#include "MachineXmlFactory.h"
+#include "Machine.h"
+#include "Box.h"
+#include "Cam.h"
+#include "Crank.h"
+#include "MusicBox.h"
+#include "Pulley.h"
+#include "Shaft.h"
+#include "Sparty.h"
+
+/// The images directory in resources
+const std::wstring ImagesDirectory = L"/images";
+
+/**
+ * A type of component that can appear in a description
+ */
+struct ComponentType
+{
+    /// Element name
+    std::wstring mName;
+    /// Attributes that must be present, besides id
+    std::vector<std::wstring> mRequired;
+    /// Attributes that may be present
+    std::vector<std::wstring> mOptional;
+    /// Can drive other components
+    bool mSource;
+    /// Can be driven by another component
+    bool mSink;
+    /// Can respond to a cam
+    bool mResponder;
+};
+
+/// The component types
+const std::vector<ComponentType> ComponentTypes = {
+    {L"box", {L"box-size", L"lid-size"}, {}, false, false, true},
+    {L"sparty", {L"image", L"size", L"spring-length", L"spring-width", L"links"}, {L"bouncy", L"spring-x"}, false, false, true},
+    {L"crank", {}, {L"x", L"y"}, true, false, false},
+    {L"shaft", {}, {L"diameter", L"length", L"x", L"y"}, true, true, false},
+    {L"pulley", {L"diameter"}, {L"at", L"side", L"x", L"y"}, true, true, false},
+    {L"cam", {}, {L"at", L"side", L"x", L"y"}, false, true, false},
+    {L"music-box", {L"song"}, {}, false, true, false},
+};
+
+/// Attributes that are not integers
+const std::set<std::wstring> TextAttributes = {L"id", L"image", L"song", L"at", L"side", L"bouncy"};
+
+/**
+ * Find a component type by name
+ * @param name Element name
+ * @return Component type or nullptr if there is none
+ */
+static const ComponentType *FindType(const std::wstring &name)
+{
+    for (auto &type : ComponentTypes)
+    {
+        if (type.mName == name)
+        {
+            return &type;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * Get an integer attribute of a component
+ * @param attributes Component attributes
+ * @param name Attribute name
+ * @param def Value if the attribute is not present
+ * @return Attribute value
+ */
+static int IntAttribute(const std::map<std::wstring, std::wstring> &attributes, const std::wstring &name, int def)
+{
+    auto found = attributes.find(name);
+    return found == attributes.end() ? def : wxAtoi(found->second);
+}
+
+/**
+ * Constructor
+ * @param resourcesDir Path to the resources directory
+ */
+MachineXmlFactory::MachineXmlFactory(std::wstring resourcesDir)
+{
+    mResourcesDir = resourcesDir;
+    mImagesDir = resourcesDir + ImagesDirectory;
+}
+
+/**
+ * Record why the description is not valid
+ * @param node Node the problem is at
+ * @param message Description of the problem
+ * @return false
+ */
+bool MachineXmlFactory::Fail(const wxXmlNode *node, const std::wstring &message)
+{
+    mError = wxString::Format(L"line %d: %s", node->GetLineNumber(), message).ToStdWstring();
+    mComponents.clear();
+    mLinks.clear();
+    return false;
+}
+
+/**
+ * Load and validate a machine description
+ * @param xmlPath Path to the description
+ * @return true if the description is valid
+ */
+bool MachineXmlFactory::Load(const std::wstring &xmlPath)
+{
+    mComponents.clear();
+    mLinks.clear();
+    mError.clear();
+
+    // Prevent error popup from wxWidgets
+    wxLogNull logNo;
+
+    wxXmlDocument xml;
+    if (!xml.Load(xmlPath) || xml.GetRoot() == nullptr)
+    {
+        mError = L"unable to read " + xmlPath;
+        return false;
+    }
+
+    return Validate(xml.GetRoot());
+}
+
+/**
+ * Read and validate the components and links of a description
+ * @param root Root node of the description
+ * @return true if the description is valid
+ */
+bool MachineXmlFactory::Validate(const wxXmlNode *root)
+{
+    if (root->GetName() != L"machine")
+    {
+        return Fail(root, L"root element must be <machine>");
+    }
+
+    // Type of each component by id
+    std::map<std::wstring, const ComponentType *> types;
+    // Component driving each sink, by belt or drive
+    std::map<std::wstring, std::wstring> drivers;
+    // Pulleys that already drive a belt
+    std::set<std::wstring> belted;
+
+    for (auto node = root->GetChildren(); node != nullptr; node = node->GetNext())
+    {
+        if (node->GetType() != wxXML_ELEMENT_NODE)
+        {
+            continue;
+        }
+
+        std::wstring name = node->GetName().ToStdWstring();
+        std::map<std::wstring, std::wstring> attributes;
+        for (auto attribute = node->GetAttributes(); attribute != nullptr; attribute = attribute->GetNext())
+        {
+            attributes[attribute->GetName().ToStdWstring()] = attribute->GetValue().ToStdWstring();
+        }
+
+        auto has = [&attributes](const std::wstring &attribute) { return attributes.count(attribute) > 0; };
+
+        if (name == L"drive" || name == L"belt" || name == L"responder")
+        {
+            // The attribute naming the link's from and to component
+            std::wstring from = name == L"drive" ? L"source" : name == L"belt" ? L"from" : L"cam";
+            std::wstring to = name == L"drive" ? L"sink" : name == L"belt" ? L"to" : L"responder";
+            if (attributes.size() != 2 || !has(from) || !has(to))
+            {
+                return Fail(node, L"<" + name + L"> needs exactly the attributes " + from + L" and " + to);
+            }
+
+            LinkSpec link{name, attributes[from], attributes[to]};
+            if (types.count(link.mFrom) == 0 || types.count(link.mTo) == 0)
+            {
+                return Fail(node, L"<" + name + L"> links an unknown component");
+            }
+
+            auto fromType = types[link.mFrom];
+            auto toType = types[link.mTo];
+            if (name == L"drive" && (!fromType->mSource || !toType->mSink))
+            {
+                return Fail(node, L"a " + fromType->mName + L" cannot drive a " + toType->mName);
+            }
+            if (name == L"belt" && (fromType->mName != L"pulley" || toType->mName != L"pulley"))
+            {
+                return Fail(node, L"belts can only connect pulleys");
+            }
+            if (name == L"belt" && !belted.insert(link.mFrom).second)
+            {
+                return Fail(node, L"pulley " + link.mFrom + L" already has a belt");
+            }
+            if (name == L"responder" && (fromType->mName != L"cam" || !toType->mResponder))
+            {
+                return Fail(node, L"a " + toType->mName + L" cannot respond to a " + fromType->mName);
+            }
+            if (name != L"responder" && !drivers.emplace(link.mTo, link.mFrom).second)
+            {
+                return Fail(node, link.mTo + L" is already driven by " + drivers[link.mTo]);
+            }
+
+            mLinks.push_back(link);
+            continue;
+        }
+
+        auto type = FindType(name);
+        if (type == nullptr)
+        {
+            return Fail(node, L"unknown element <" + name + L">");
+        }
+
+        if (!has(L"id") || attributes[L"id"].empty())
+        {
+            return Fail(node, L"<" + name + L"> needs an id");
+        }
+
+        std::wstring id = attributes[L"id"];
+        if (!types.emplace(id, type).second)
+        {
+            return Fail(node, L"duplicate id " + id);
+        }
+
+        for (auto &required : type->mRequired)
+        {
+            if (!has(required))
+            {
+                return Fail(node, L"<" + name + L"> needs the attribute " + required);
+            }
+        }
+
+        for (auto &attribute : attributes)
+        {
+            auto &allowed = type->mOptional;
+            if (attribute.first != L"id" &&
+                std::find(type->mRequired.begin(), type->mRequired.end(), attribute.first) == type->mRequired.end() &&
+                std::find(allowed.begin(), allowed.end(), attribute.first) == allowed.end())
+            {
+                return Fail(node, L"<" + name + L"> has no attribute " + attribute.first);
+            }
+
+            long value;
+            if (TextAttributes.count(attribute.first) == 0 && !wxString(attribute.second).ToLong(&value))
+            {
+                return Fail(node, attribute.first + L" must be an integer");
+            }
+        }
+
+        if (has(L"bouncy") && attributes[L"bouncy"] != L"true" && attributes[L"bouncy"] != L"false")
+        {
+            return Fail(node, L"bouncy must be true or false");
+        }
+
+        if (has(L"x") != has(L"y"))
+        {
+            return Fail(node, L"x and y must be given together");
+        }
+
+        // Pulleys and cams are placed on the end of a shaft or at a location
+        if (name == L"pulley" || name == L"cam")
+        {
+            if (has(L"at") == has(L"x") || has(L"at") != has(L"side"))
+            {
+                return Fail(node, L"<" + name + L"> needs either at and side or x and y");
+            }
+
+            if (has(L"at"))
+            {
+                auto at = types.find(attributes[L"at"]);
+                if (at == types.end() || at->second->mName != L"shaft")
+                {
+                    return Fail(node, L"at must name a shaft declared before the " + name);
+                }
+
+                if (attributes[L"side"] != L"left" && attributes[L"side"] != L"right")
+                {
+                    return Fail(node, L"side must be left or right");
+                }
+            }
+        }
+
+        mComponents.push_back({name, attributes});
+    }
+
+    // Each sink has at most one driver, so a cycle is a driver chain that comes back on itself
+    for (auto &driven : drivers)
+    {
+        std::set<std::wstring> chain = {driven.first};
+        for (auto driver = drivers.find(driven.first); driver != drivers.end(); driver = drivers.find(driver->second))
+        {
+            if (!chain.insert(driver->second).second)
+            {
+                return Fail(root, L"the drive through " + driven.first + L" is a loop");
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Create a machine from the loaded description
+ * @return Pointer to created machine or nullptr if no valid description is loaded
+ */
+std::shared_ptr<Machine> MachineXmlFactory::Create()
+{
+    if (mComponents.empty())
+    {
+        return nullptr;
+    }
+
+    // The machine itself
+    auto machine = std::make_shared<Machine>();
+
+    std::map<std::wstring, RotationSource *> sources;
+    std::map<std::wstring, std::shared_ptr<IRotationSink>> sinks;
+    std::map<std::wstring, std::shared_ptr<IKeyResponder>> responders;
+    std::map<std::wstring, std::shared_ptr<Shaft>> shafts;
+    std::map<std::wstring, std::shared_ptr<Pulley>> pulleys;
+    std::map<std::wstring, std::shared_ptr<Cam>> cams;
+
+    for (auto &spec : mComponents)
+    {
+        auto &attributes = spec.mAttributes;
+        auto &id = attributes.at(L"id");
+
+        // Location from x and y, or the end of a shaft
+        wxPoint location(IntAttribute(attributes, L"x", 0), IntAttribute(attributes, L"y", 0));
+        if (attributes.count(L"at") > 0)
+        {
+            auto &shaft = shafts[attributes.at(L"at")];
+            location = attributes.at(L"side") == L"left" ? shaft->GetLeftCenter() : shaft->GetRightCenter();
+        }
+
+        std::shared_ptr<Component> component;
+        if (spec.mType == L"box")
+        {
+            auto box = machine->Create<Box>(mImagesDir, IntAttribute(attributes, L"box-size", 0),
+                                             IntAttribute(attributes, L"lid-size", 0));
+            responders[id] = box;
+            component = box;
+        }
+        else if (spec.mType == L"sparty")
+        {
+            auto sparty = machine->Create<Sparty>(mImagesDir + L"/" + attributes.at(L"image"),
+                                                   IntAttribute(attributes, L"size", 0),
+                                                   IntAttribute(attributes, L"spring-length", 0),
+                                                   IntAttribute(attributes, L"spring-width", 0),
+                                                   IntAttribute(attributes, L"links", 0),
+                                                   attributes.count(L"bouncy") > 0 && attributes.at(L"bouncy") == L"true",
+                                                   IntAttribute(attributes, L"spring-x", 0));
+            responders[id] = sparty;
+            component = sparty;
+        }
+        else if (spec.mType == L"crank")
+        {
+            auto crank = machine->Create<Crank>(location);
+            sources[id] = crank->GetSource();
+            component = crank;
+        }
+        else if (spec.mType == L"shaft")
+        {
+            if (attributes.count(L"x") == 0)
+            {
+                location = DefaultPoint;
+            }
+
+            auto shaft = machine->Create<Shaft>(IntAttribute(attributes, L"diameter", ShaftDiameter),
+                                                 IntAttribute(attributes, L"length", ShaftLength), location);
+            sources[id] = shaft->GetSource();
+            sinks[id] = shaft;
+            shafts[id] = shaft;
+            component = shaft;
+        }
+        else if (spec.mType == L"pulley")
+        {
+            auto pulley = machine->Create<Pulley>(IntAttribute(attributes, L"diameter", 0), location);
+            sources[id] = pulley->GetSource();
+            sinks[id] = pulley;
+            pulleys[id] = pulley;
+            component = pulley;
+        }
+        else if (spec.mType == L"cam")
+        {
+            auto cam = machine->Create<Cam>(mImagesDir, location);
+            sinks[id] = cam;
+            cams[id] = cam;
+            component = cam;
+        }
+        else if (spec.mType == L"music-box")
+        {
+            auto music = machine->Create<MusicBox>(mResourcesDir, attributes.at(L"song"));
+            sinks[id] = music;
+            component = music;
+        }
+
+        machine->AddComponent(component);
+    }
+
+    for (auto &link : mLinks)
+    {
+        if (link.mType == L"drive")
+        {
+            sources[link.mFrom]->AddSink(sinks[link.mTo]);
+        }
+        else if (link.mType == L"belt")
+        {
+            pulleys[link.mFrom]->BeltTo(pulleys[link.mTo]);
+        }
+        else
+        {
+            cams[link.mFrom]->AddResponder(responders[link.mTo]);
+        }
+    }
+
+    return machine;
+}
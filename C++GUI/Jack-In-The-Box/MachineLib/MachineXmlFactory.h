@@ -0,0 +1,93 @@
+/**
+ * @file MachineXmlFactory.h
+ * @author Jaylon Sifuentes
+ *
+ * Factory that creates machines from XML machine descriptions.
+ */
+
+#ifndef MACHINEXMLFACTORY_H
+#define MACHINEXMLFACTORY_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Machine;
+class wxXmlNode;
+
+/**
+ * Factory that creates machines from XML machine descriptions.
+ *
+ * A description lists the components of a machine with their
+ * parameters, followed by the links between them:
+ *
+ *     <machine>
+ *         <crank id="crank"/>
+ *         <shaft id="shaft" diameter="10" length="80" x="90" y="-185"/>
+ *         <pulley id="pulley" diameter="40" at="shaft" side="left"/>
+ *         <drive source="crank" sink="shaft"/>
+ *         <belt from="pulley" to="other-pulley"/>
+ *         <responder cam="cam" responder="box"/>
+ *     </machine>
+ *
+ * The whole description is validated when it is loaded, so
+ * Create only builds machines from descriptions known to be good.
+ */
+class MachineXmlFactory
+{
+private:
+    /// A component in the description
+    struct ComponentSpec
+    {
+        /// Component type, the element name
+        std::wstring mType;
+        /// Attributes of the component
+        std::map<std::wstring, std::wstring> mAttributes;
+    };
+
+    /// A link between two components
+    struct LinkSpec
+    {
+        /// Link type, the element name
+        std::wstring mType;
+        /// Component the link is from
+        std::wstring mFrom;
+        /// Component the link is to
+        std::wstring mTo;
+    };
+
+    /// Path to the resources directory
+    std::wstring mResourcesDir;
+
+    /// Path to the images directory
+    std::wstring mImagesDir;
+
+    /// The components in the order they are added to the machine
+    std::vector<ComponentSpec> mComponents;
+
+    /// The links in the order they are made
+    std::vector<LinkSpec> mLinks;
+
+    /// Why the description is not valid
+    std::wstring mError;
+
+    bool Fail(const wxXmlNode *node, const std::wstring &message);
+    bool Validate(const wxXmlNode *root);
+
+public:
+    MachineXmlFactory(std::wstring resourcesDir);
+
+    bool Load(const std::wstring &xmlPath);
+
+    std::shared_ptr<Machine> Create();
+
+    /**
+     * Get the reason Load failed
+     * @return Error message
+     */
+    const std::wstring &GetError() const { return mError; }
+};
+
+
+#endif //MACHINEXMLFACTORY_H
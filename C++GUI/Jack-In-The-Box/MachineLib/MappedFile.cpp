@@ -0,0 +1,97 @@
+/**
+ * @file MappedFile.cpp
+ * @author Jaylon Sifuentes
+ */
+
+#include "pch.h"
+#include <wx/file.h>
+#include "MappedFile.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Destructor
+ */
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+/**
+ * Open a file
+ * @param filename File to open
+ * @return true if successful
+ */
+bool MappedFile::Open(const std::wstring &filename)
+{
+    Close();
+
+#ifndef _WIN32
+    int fd = open(wxString(filename).fn_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0)
+    {
+        void *data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            mData = (const char *)data;
+            mSize = info.st_size;
+            mMapped = true;
+        }
+    }
+
+    close(fd);
+    if (mMapped)
+    {
+        return true;
+    }
+#endif
+
+    // Prevent error popup from wxWidgets
+    wxLogNull logNo;
+
+    wxFile file;
+    if (!file.Open(filename))
+    {
+        return false;
+    }
+
+    mContents.resize(file.Length());
+    if (file.Read(mContents.data(), mContents.size()) != (ssize_t)mContents.size())
+    {
+        mContents.clear();
+        return false;
+    }
+
+    mData = mContents.data();
+    mSize = mContents.size();
+    return true;
+}
+
+/**
+ * Close the file. Any pointers into it become invalid.
+ */
+void MappedFile::Close()
+{
+#ifndef _WIN32
+    if (mMapped)
+    {
+        munmap((void *)mData, mSize);
+    }
+#endif
+
+    mContents.clear();
+    mData = nullptr;
+    mSize = 0;
+    mMapped = false;
+}
@@ -0,0 +1,64 @@
+/**
+ * @file MappedFile.h
+ * @author Jaylon Sifuentes
+ *
+ * Read only view of a whole file.
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * Read only view of a whole file.
+ *
+ * On POSIX systems the file is memory mapped, so pages are only
+ * read when they are used. Elsewhere the file is read into memory.
+ */
+class MappedFile
+{
+private:
+    /// Start of the file data
+    const char *mData = nullptr;
+
+    /// Size of the file in bytes
+    size_t mSize = 0;
+
+    /// True if mData is a memory mapping
+    bool mMapped = false;
+
+    /// File contents when the file could not be mapped
+    std::vector<char> mContents;
+
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    /// Copy constructor (disabled)
+    MappedFile(const MappedFile &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const MappedFile &) = delete;
+
+    bool Open(const std::wstring &filename);
+
+    void Close();
+
+    /**
+     * Get the file data
+     * @return Start of the file data
+     */
+    const char *GetData() const { return mData; }
+
+    /**
+     * Get the file size
+     * @return Size in bytes
+     */
+    size_t GetSize() const { return mSize; }
+};
+
+
+#endif //MAPPEDFILE_H
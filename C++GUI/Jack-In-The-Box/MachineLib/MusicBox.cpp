@@ -4,7 +4,11 @@
  */
 
 #include "pch.h"
+#include <algorithm>
 #include "MusicBox.h"
+#include "DisplayList.h"
+#include "AudioRecorder.h"
+#include "Tracer.h"
 
 /// The music box mechanism image filename
 const std::wstring MusicBoxImage = L"/images/mechanism.png";
@@ -37,6 +41,7 @@ const int DrumLineCount = 6;
 MusicBox::MusicBox(std::wstring resourcesDir, std::wstring songXmlPath)
 {
     mResourcesDir = resourcesDir;
+    mAudio = AudioEngine::GetShared();
     mMusicBoxImg.Rectangle(0, 0, MusicBoxImageSize, MusicBoxImageSize);
     mMusicBoxImg.SetImage(resourcesDir + MusicBoxImage);
     mDrumCylinder.SetSize(MusicBoxDrumDiameter, MusicBoxDrumWidth);
@@ -52,99 +57,134 @@ MusicBox::MusicBox(std::wstring resourcesDir, std::wstring songXmlPath)
  */
 void MusicBox::LoadXMLSong(std::wstring xmlPath)
 {
-    wxXmlDocument notesXml;
-    notesXml.Load(xmlPath);
-    wxXmlNode* root = notesXml.GetRoot();
-    mBeatsPerMeasure = wxAtoi(root->GetAttribute("beats"));
-    wxXmlNode* soundsSection = root->GetChildren();
-    /*
-     * Gather all the sounds and store them in a dict
-     * with key value pair: note, sound file
-     */
-    while (soundsSection)
+    // Uses the compiled binary song when there is an up to date one
+    mSong.Open(xmlPath);
+    mBeatsPerMeasure = mSong.GetBeatsPerMeasure();
+
+    // Decode each sound once, indexed by note id
+    mSounds.clear();
+    for (auto &file : mSong.GetSoundFiles())
     {
-        if (soundsSection->GetName() == "sounds")
-        {
-            wxXmlNode* soundLine = soundsSection->GetChildren();
-            while (soundLine)
-            {
-                if (soundLine->GetName() == "sound")
-                {
-                    std::wstring note = soundLine->GetAttribute(L"note").ToStdWstring();
-                    wxString file = mResourcesDir + AudioDirectory + soundLine->GetAttribute("file");
-                    mSounds[note] = file;
-                }
-                soundLine = soundLine->GetNext();
-            }
-        }
-        soundsSection = soundsSection->GetNext();
+        mSounds.push_back(file.empty() ? -1 : mAudio->LoadSound(mResourcesDir + AudioDirectory + file));
     }
+}
 
-    /*
-     * Gather all the notes and store them
-     * in a list of pairs: note, absolute beat.
-     */
-    wxXmlNode* notesSection = root->GetChildren();
-    while (notesSection)
+/**
+ * Move the note index to the first note after a beat.
+ *
+ * Notes up to and including the beat count as played, since the
+ * update that reached the beat struck them. At the start of the
+ * song nothing has been struck yet, so notes on the first beat
+ * are still to be played, as they are in a fresh run.
+ *
+ * @param beat Beat the drum is at
+ */
+void MusicBox::SeekNoteIndex(double beat)
+{
+    auto notes = mSong.GetNotes();
+    auto end = notes + mSong.GetNoteCount();
+    if (beat <= 0)
     {
-        if (notesSection->GetName() == "notes")
-        {
-            wxXmlNode* noteLine = notesSection->GetChildren();
-            while (noteLine)
-            {
-                if (noteLine->GetName() == "note")
-                {
-                    int measure = wxAtoi(noteLine->GetAttribute("measure"));
-                    double beat = wxAtof(noteLine->GetAttribute("beat"));
-                    std::wstring note = noteLine->GetAttribute("note").ToStdWstring();
-                    // Absolute beat equation
-                    double absoluteBeat = (measure - 1) * mBeatsPerMeasure + (beat - 1);
-                    mNotes.push_back({note, absoluteBeat});
-                }
-                noteLine = noteLine->GetNext();
-            }
-        }
-        notesSection = notesSection->GetNext();
+        auto next = std::lower_bound(notes, end, beat, [](const Song::Note &note, double beat) {
+            return note.mBeat < beat;
+        });
+        mNoteIndex = (int)(next - notes);
+        return;
     }
+
+    auto next = std::upper_bound(notes, end, beat, [](double beat, const Song::Note &note) {
+        return beat < note.mBeat;
+    });
+    mNoteIndex = (int)(next - notes);
 }
 
-void MusicBox::PlayNote(std::wstring note)
+void MusicBox::PlayNote(uint16_t sound, double time)
 {
+    Tracer::Span span("MusicBox::PlayNote", "audio");
+    int id = mSounds[sound];
+    if (mSeeking || id < 0)
+    {
+        return;
+    }
+
+    // The recording gets every note, muting only affects live playback
+    if (mRecorder != nullptr)
+    {
+        mRecorder->Record(mAudio->GetSamples(id), time);
+    }
+
     if (!mMuted)
     {
-        wxSound sound(mSounds[note]);
-        // async so program continues as normal
-        sound.Play(wxSOUND_ASYNC);
+        // Only queues the note, the shared mixer plays it
+        // offset from the current frame so it keeps its timing
+        mAudio->Trigger(id, time - GetTime());
     }
 }
 
 
 void MusicBox::UpdateRotation(double rotation)
 {
+    double lastTime = mLastTime;
+    double lastBeat = mRotation * mBeatsPerMeasure / 2;
     mRotation = rotation;
+    mLastTime = GetTime();
     // Calculate beat based on rotation
     double beat = rotation * mBeatsPerMeasure / 2;
 
-    // When beat is greater than or equal to the next beat waiting to be played, play the beat
-    while (mNoteIndex < mNotes.size() && beat >= mNotes[mNoteIndex].second)
+    // Jumps and reverse rotation play nothing, just find where the song is
+    if (mSeeking || beat < lastBeat)
+    {
+        SeekNoteIndex(beat);
+        return;
+    }
+
+    /*
+     * When beat is greater than or equal to the next beat waiting to be played, play the beat.
+     * The drum turns at a constant speed between updates, so the time
+     * each note is struck is interpolated from the last update.
+     */
+    auto notes = mSong.GetNotes();
+    while (mNoteIndex < mSong.GetNoteCount() && beat >= notes[mNoteIndex].mBeat)
     {
-        PlayNote(mNotes[mNoteIndex].first);
+        double fraction = 1;
+        if (lastBeat < notes[mNoteIndex].mBeat)
+        {
+            fraction = (notes[mNoteIndex].mBeat - lastBeat) / (beat - lastBeat);
+        }
+        PlayNote(notes[mNoteIndex].mSound, lastTime + (mLastTime - lastTime) * fraction);
         mNoteIndex++;
     }
 }
 
-void MusicBox::DrawComponentBackground(std::shared_ptr<wxGraphicsContext> graphics)
+void MusicBox::DrawComponentBackground(DisplayList &list) const
 {
-    mMusicBoxImg.DrawPolygon(graphics, GetX() - MusicBoxImageSize / 2, GetY() - MusicBoxImageSize / MusicBoxYResize);
-    mDrumCylinder.Draw(graphics, GetX() - MusicBoxImageSize / DrumXResize, GetY() - MusicBoxImageSize / DrumYResize, mRotation / DrumRotDiv);
+    list.DrawPolygon(mMusicBoxImg, GetX() - MusicBoxImageSize / 2, GetY() - MusicBoxImageSize / MusicBoxYResize);
+    list.DrawCylinder(mDrumCylinder, GetX() - MusicBoxImageSize / DrumXResize, GetY() - MusicBoxImageSize / DrumYResize, mRotation / DrumRotDiv);
 }
 
-void MusicBox::DrawComponentForeground(std::shared_ptr<wxGraphicsContext> graphics)
+void MusicBox::DrawComponentForeground(DisplayList &list) const
 {
 }
 
 void MusicBox::Reset()
 {
     mRotation = 0;
+    mLastTime = 0;
     mNoteIndex = 0;
 }
+
+void MusicBox::SaveState(Checkpoint &checkpoint)
+{
+    Component::SaveState(checkpoint);	// Upcall
+    checkpoint.Write(mRotation);
+    checkpoint.Write(mLastTime);
+    checkpoint.Write(mNoteIndex);
+}
+
+void MusicBox::RestoreState(Checkpoint &checkpoint)
+{
+    Component::RestoreState(checkpoint);	// Upcall
+    mRotation = checkpoint.Read();
+    mLastTime = checkpoint.Read();
+    mNoteIndex = (int)checkpoint.Read();
+}
@@ -7,13 +7,12 @@
 
 #ifndef MUSICBOX_H
 #define MUSICBOX_H
-#include <map>
-#include <wx/sound.h>
-#include <wx/xml/xml.h>
+#include "AudioEngine.h"
 #include "Component.h"
 #include "Cylinder.h"
 #include "IRotationSink.h"
 #include "Polygon.h"
+#include "Song.h"
 
 /**
  * Objects of this class are a music box that play
@@ -22,23 +21,34 @@
 class MusicBox : public Component, public IRotationSink
 {
 private:
+
     /// Rotation received from source
     double mRotation = 0;
+    /// Machine time of the last rotation update
+    double mLastTime = 0;
     /// Resources directory. Seperate variable for XML loading .wav's
     std::wstring mResourcesDir;
     /// Beats per measure at top of XML
     int mBeatsPerMeasure = 0;
     /// If the box is muted
     bool mMuted = false;
-    /// Dictionary that stores all notes and their corresponding sound files
-    std::map<std::wstring, wxString> mSounds;
-    /// List that stores notes and corresponding beat calculation
-    std::vector<std::pair<std::wstring, double>> mNotes;
+    /// Recorder that receives every note played, if any
+    AudioRecorder *mRecorder = nullptr;
+    /// True while the machine is seeking. No notes are played.
+    bool mSeeking = false;
+    /// Mixer that plays the decoded note sounds, shared by every music box
+    std::shared_ptr<AudioEngine> mAudio;
+    /// Sound id in mAudio for each note id of the song
+    std::vector<int> mSounds;
+    /// The song, which holds the notes sorted by beat
+    Song mSong;
     /**
      * Index increased during rotation.
-     * Determines note to play from mNotes
+     * Determines note to play from the song's notes
      */
     int mNoteIndex = 0;
+
+    void SeekNoteIndex(double beat);
     /// Image for drawing music box
     cse335::Polygon mMusicBoxImg;
     /// Image for drawing music box rotating cylinder
@@ -54,23 +64,46 @@ public:
     MusicBox(std::wstring resourcesDir, std::wstring songXmlPath);
     /**
     * Draw the component at the currently specified location in the background.
-    * @param graphics Graphics object to render to
+    * @param list Display list to record the drawing into
     */
-    void DrawComponentBackground(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void DrawComponentBackground(DisplayList &list) const override;
     /**
     * Draw the component at the currently specified location in the background.
-    * @param graphics Graphics object to render to
+    * @param list Display list to record the drawing into
     */
-    void DrawComponentForeground(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void DrawComponentForeground(DisplayList &list) const override;
     /**
     * Reset Music box attributes
     */
     void Reset() override;
+
+    /**
+     * Save the simulation state of this component
+     * @param checkpoint Checkpoint to write the state to
+     */
+    void SaveState(Checkpoint &checkpoint) override;
+
+    /**
+     * Restore the simulation state of this component
+     * @param checkpoint Checkpoint to read the state from
+     */
+    void RestoreState(Checkpoint &checkpoint) override;
     /**
      * Mute the music box
      * @param mute if the music box should be muted
      */
-    void Mute(bool mute) { mMuted = mute; }
+    void Mute(bool mute) override { mMuted = mute; }
+    /**
+     * Set if the machine is seeking rather than playing.
+     * Notes passed over while seeking are skipped silently.
+     * @param seeking True while the machine is seeking
+     */
+    void SetSeeking(bool seeking) override { mSeeking = seeking; }
+    /**
+     * Set a recorder that receives every note played
+     * @param recorder Recorder to use or nullptr to stop recording
+     */
+    void SetRecorder(AudioRecorder *recorder) override { mRecorder = recorder; }
     /**
      * Updates the rotation of the music box based on its source.
      * Used to progress song.
@@ -79,16 +112,17 @@ public:
      */
     void UpdateRotation(double rotation) override;
     /**
-     * Loads XML song info and stores in dict+list
+     * Loads XML song info and decodes its sounds
      * to make it playable.
      * @param xmlPath xml file path for song
      */
     void LoadXMLSong(std::wstring xmlPath);
     /**
      * Plays a given note's respective .wav
-     * @param note note to play
+     * @param sound index of the note's sound in mSounds
+     * @param time machine time the note is struck
      */
-    void PlayNote(std::wstring note);
+    void PlayNote(uint16_t sound, double time);
 };
 
 
@@ -15,13 +15,15 @@
 #include <wx/hyperlink.h>
 #include <wx/generic/hyperlink.h>
 #include "Polygon.h"
+#include "ImageCache.h"
+#include "Tracer.h"
 
 using namespace cse335;
 
 /**
  * Constructor
  */
-Polygon::Polygon() : mBrush(*wxBLACK)
+Polygon::Polygon() : mBrush(wxColour(0, 0, 0))
 {
 }
 
@@ -194,7 +196,9 @@ void Polygon::Circle(double radius, int steps)
  */
 void Polygon::SetColor(wxColour color)
 {
-    mBrush.SetColour(color);
+    // A copy of the channels, so the brush shares no data with stock or
+    // file scope colors that polygons on other threads may also use
+    mBrush.SetColour(wxColour(color.Red(), color.Green(), color.Blue(), color.Alpha()));
     mMode = Mode::Color;
 }
 
@@ -204,11 +208,11 @@ void Polygon::SetColor(wxColour color)
  */
 void Polygon::SetImage(std::wstring filename)
 {
-    // Prevent error popup from wxWidgets
-    wxLogNull logNo;
-
-    mImage = std::make_unique<wxImage>();
-    if(mImage->LoadFile(filename, wxBITMAP_TYPE_ANY))
+    Tracer::Span span("Polygon::SetImage", "image");
+    mImageFile = filename;
+    mImage = ImageCache::GetImage(filename);
+    mBitmapDirty = true;
+    if(mImage != nullptr)
     {
         mMode = Mode::Image;
     }
@@ -230,7 +234,7 @@ void Polygon::SetImage(std::wstring filename)
  * @param y Y location to draw in pixels
  * @param rotation Amount of rotation to apply to the polygon in turns (optional parameter)
  */
-void Polygon::DrawPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y, double rotation)
+void Polygon::DrawPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y, double rotation) const
 {
     if(mPoints.size() < 3)
     {
@@ -286,7 +290,7 @@ void Polygon::DrawPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x,
  * @param y Y location to draw in pixels
  * @param rotation Amount of rotation to apply to the polygon in turns
  */
-void Polygon::DrawColorPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y, double rotation)
+void Polygon::DrawColorPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y, double rotation) const
 {
     if(mPath.IsNull())
     {
@@ -323,7 +327,7 @@ void Polygon::DrawColorPolygon(std::shared_ptr<wxGraphicsContext> graphics, doub
  * @param y Y location to draw in pixels
  * @param rotation Amount of rotation to apply to the polygon in turns
  */
-void Polygon::DrawImagePolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y, double rotation)
+void Polygon::DrawImagePolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y, double rotation) const
 {
     if(mBitmapDirty || mGraphicsBitmap.IsNull())
     {
@@ -331,13 +335,14 @@ void Polygon::DrawImagePolygon(std::shared_ptr<wxGraphicsContext> graphics, doub
         // Implementation of opacity for Windows systems.
         // Windows does not support transparency layers.
         if(mOpacity < 1) {
+            // The cached image is shared, so work on a copy
+            wxImage img = mImage->Copy();
+
             // Ensure the image has an alpha map
-            if (!mImage->HasAlpha()) {
-                mImage->InitAlpha();
+            if (!img.HasAlpha()) {
+                img.InitAlpha();
             }
 
-            wxImage img = mImage->Copy();
-
             unsigned char *alpha = img.GetAlpha();
             for(int i=0; i<img.GetWidth()*img.GetHeight(); i++)
             {
@@ -348,10 +353,10 @@ void Polygon::DrawImagePolygon(std::shared_ptr<wxGraphicsContext> graphics, doub
         }
         else
         {
-            mGraphicsBitmap = graphics->CreateBitmapFromImage(*mImage);
+            mGraphicsBitmap = ImageCache::GetBitmap(graphics, mImageFile);
         }
 #else
-        mGraphicsBitmap = graphics->CreateBitmapFromImage(*mImage);
+        mGraphicsBitmap = ImageCache::GetBitmap(graphics, mImageFile);
 #endif
 
         //
@@ -472,7 +477,7 @@ int Polygon::GetImageHeight()
  * @param url Optional URL to display with the error
  * @return Assertion condition result, true if condition is true
  */
-bool Polygon::Assert(bool condition, wxString msg, const wxString &url)
+bool Polygon::Assert(bool condition, wxString msg, const wxString &url) const
 {
     if(condition)
     {
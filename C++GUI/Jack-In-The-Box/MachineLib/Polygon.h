@@ -4,7 +4,7 @@
  * @author Anik Momtaz
  * @author Charles Owen
  *
- * @version 1.06
+ * @version 1.08
  *
  * Generic polygon class that is used to make shapes we
  * will use in our project.
@@ -17,6 +17,8 @@
  * 1.04 Added Circle function
  * 1.05 Special version that works with inverted Y axis
  * 1.06 Updated links to the new website
+ * 1.07 Drawing is const so it cannot change simulation state
+ * 1.08 Images are shared through the image cache
  */
 
 #pragma once
@@ -36,11 +38,11 @@ namespace cse335 {
         /// Default number of steps when drawing a circle
         static const int DefaultCircleSteps = 32;
 
-        void DrawColorPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y, double rotation);
-        void DrawImagePolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y, double rotation);
+        void DrawColorPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y, double rotation) const;
+        void DrawImagePolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y, double rotation) const;
 
-        /// Graphics path to use to draw
-        wxGraphicsPath mPath;
+        /// Graphics path to use to draw (created on first draw)
+        mutable wxGraphicsPath mPath;
 
         /// The points that make up the polygon
         std::vector<wxPoint2DDouble> mPoints;
@@ -59,29 +61,32 @@ namespace cse335 {
         /// The current mode
         Mode mMode = Mode::Unset;
 
-        /// The basic texture image we load
-        std::unique_ptr<wxImage> mImage;
+        /// The basic texture image we load, shared through the image cache
+        std::shared_ptr<const wxImage> mImage;
+
+        /// The texture image filename
+        std::wstring mImageFile;
 
         /// The graphics bitmap we actually draw
-        wxGraphicsBitmap mGraphicsBitmap;
+        mutable wxGraphicsBitmap mGraphicsBitmap;
 
         /// The image clip region
-        wxRegion mImageClipRegion;
+        mutable wxRegion mImageClipRegion;
 
         /// What is the top left point for the clip region?
-        wxPoint2DDouble mImageClipRegionTopLeft;
+        mutable wxPoint2DDouble mImageClipRegionTopLeft;
 
         /// What is the size of the clip region?
-        wxPoint2DDouble mImageClipRegionSize;
+        mutable wxPoint2DDouble mImageClipRegionSize;
 
         /// Set true when DrawPolygon is called
-        bool mHasDrawn = false;
+        mutable bool mHasDrawn = false;
 
         /// Opacity of the polygon - value range to 0 to 1
         double mOpacity = 1.0;
 
         /// Forces the bitmap to be reloaded
-        bool mBitmapDirty = true;
+        mutable bool mBitmapDirty = true;
 
 #ifdef POLYGON_DEFAULT_INVERTEDY
         /// Is the Y axis inverted (positive Y is up)?
@@ -91,7 +96,7 @@ namespace cse335 {
         bool mInvertedY = false;
 #endif
 
-        bool Assert(bool condition, wxString msg, const wxString& url = wxEmptyString);
+        bool Assert(bool condition, wxString msg, const wxString& url = wxEmptyString) const;
 
         //<editor-fold desc="Code to support the deferred assertion message box" defaultstate="collapsed">
         /**
@@ -116,7 +121,7 @@ namespace cse335 {
         };
 
         /// Delayed message object
-        std::shared_ptr<DelayedMessage> mDelayedMessage;
+        mutable std::shared_ptr<DelayedMessage> mDelayedMessage;
         //</editor-fold>
 
     public:
@@ -142,7 +147,7 @@ namespace cse335 {
 
         void SetImage(std::wstring filename);
 
-        void DrawPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y, double rotation=0);
+        void DrawPolygon(std::shared_ptr<wxGraphicsContext> graphics, double x, double y, double rotation=0) const;
 
         virtual void SetOpacity(double opacity);
 
@@ -5,6 +5,7 @@
 
 #include "pch.h"
 #include "Pulley.h"
+#include "DisplayList.h"
 
 /// How wide the hub is on each side of the pulley
 const double PulleyHubWidth = 3;
@@ -50,14 +51,14 @@ Pulley::Pulley(double diameter, wxPoint pos) : Component(), mRotationSource()
     mPulleyHub2.SetLines(PulleyHubLineColor, PulleyHubLineWidth, (diameter / PulleyHubLineCountDiviser));
 }
 
-void Pulley::DrawComponentBackground(std::shared_ptr<wxGraphicsContext> graphics)
+void Pulley::DrawComponentBackground(DisplayList &list) const
 {
 }
 
-void Pulley::DrawComponentForeground(std::shared_ptr<wxGraphicsContext> graphics)
+void Pulley::DrawComponentForeground(DisplayList &list) const
 {
-    mPulleyHub1.Draw(graphics, GetX(), GetY(), mRotation);
-    mPulleyHub2.Draw(graphics, GetX() + PulleyHubDistance, GetY(), mRotation);
+    list.DrawCylinder(mPulleyHub1, GetX(), GetY(), *mRotation);
+    list.DrawCylinder(mPulleyHub2, GetX() + PulleyHubDistance, GetY(), *mRotation);
 
 
     if (mBeltConnectedPulley != nullptr)
@@ -68,11 +69,11 @@ void Pulley::DrawComponentForeground(std::shared_ptr<wxGraphicsContext> graphics
          */
         if (GetY() > mBeltConnectedPulley->GetY())
         {
-            mBelt.DrawPolygon(graphics, GetX() + (PulleyHubDistance / BeltXOffset), GetY() + (mPulleyDiameter / 2));
+            list.DrawPolygon(mBelt, GetX() + (PulleyHubDistance / BeltXOffset), GetY() + (mPulleyDiameter / 2));
         }
         else
         {
-            mBelt.DrawPolygon(graphics, GetX() + (PulleyHubDistance / BeltXOffset),
+            list.DrawPolygon(mBelt, GetX() + (PulleyHubDistance / BeltXOffset),
                               mBeltConnectedPulley->GetY() + mBeltConnectedPulley->GetDiameter() / 2);
         }
     }
@@ -80,26 +81,53 @@ void Pulley::DrawComponentForeground(std::shared_ptr<wxGraphicsContext> graphics
 
 void Pulley::Reset()
 {
-    mRotation = 0;
+    *mRotation = 0;
+}
+
+void Pulley::Bind(ComponentStore &store)
+{
+    Component::Bind(store);	// Upcall
+    mRotation = store.AddRotation(*mRotation);
 }
 
 void Pulley::UpdateRotation(double rotation)
 {
 
-    mRotation = rotation;
-    mRotationSource.SetRotation(mRotation); // Set the rotation of the rotation source
+    *mRotation = rotation;
+    mRotationSource.SetRotation(*mRotation); // Set the rotation of the rotation source
 
     // If there is a pulley connected to this one, update its rotation.
     if (mBeltConnectedPulley != nullptr)
     {
-        /*
-         *If a pulley with radius N drives a pulley with radius M using the belt,
-         *the speed of the second pulley is N/M times the speed of the first pulley.
-         */
-        double driverPullyRadius = mPulleyDiameter / 2;
-        double connectedPulleyRadius = mBeltConnectedPulley->GetDiameter() / 2;
-        double speedCal = driverPullyRadius / connectedPulleyRadius;
-        mBeltConnectedPulley->UpdateRotation(mRotation * speedCal);
+        mBeltConnectedPulley->UpdateRotation(*mRotation * BeltRatio());
+    }
+}
+
+double Pulley::BeltRatio()
+{
+    /*
+     *If a pulley with radius N drives a pulley with radius M using the belt,
+     *the speed of the second pulley is N/M times the speed of the first pulley.
+     */
+    double driverPullyRadius = mPulleyDiameter / 2;
+    double connectedPulleyRadius = mBeltConnectedPulley->GetDiameter() / 2;
+    return driverPullyRadius / connectedPulleyRadius;
+}
+
+void Pulley::AddToTable(DriveTable &table, double multiplier)
+{
+    table.AddRotation(mRotation, multiplier);
+}
+
+void Pulley::Compile(DriveTable &table, double multiplier)
+{
+    AddToTable(table, multiplier);
+    mRotationSource.Compile(table, multiplier);
+
+    // Fold the belt ratio into everything the connected pulley drives
+    if (mBeltConnectedPulley != nullptr)
+    {
+        mBeltConnectedPulley->Compile(table, multiplier * BeltRatio());
     }
 }
 
@@ -108,6 +136,8 @@ void Pulley::UpdateRotation(double rotation)
 void Pulley::BeltTo(std::shared_ptr<Pulley> pulley)
 {
     mBeltConnectedPulley = pulley;
+    pulley->mRotationSource.SetDriver(&mRotationSource);
+    mRotationSource.Invalidate();
     /*
      * Determine belt height based on the difference between pulley center points
      * and overhang past these points.
@@ -117,3 +147,15 @@ void Pulley::BeltTo(std::shared_ptr<Pulley> pulley)
     mBelt.Rectangle(0, 0, BeltWidth, height);
     mBelt.SetColor(*wxBLACK);
 }
+
+void Pulley::SaveState(Checkpoint &checkpoint)
+{
+    Component::SaveState(checkpoint);	// Upcall
+    checkpoint.Write(*mRotation);
+}
+
+void Pulley::RestoreState(Checkpoint &checkpoint)
+{
+    Component::RestoreState(checkpoint);	// Upcall
+    *mRotation = checkpoint.Read();
+}
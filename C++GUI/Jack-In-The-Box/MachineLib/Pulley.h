@@ -24,8 +24,11 @@
 class Pulley : public Component, public IRotationSink
 {
 private:
-    /// Rotation of the pulley
-    double mRotation = 0;
+    /// Rotation of the pulley while it is not part of a machine
+    double mUnboundRotation = 0;
+    /// Rotation of the pulley.
+    /// Points into the machine's component store once bound.
+    double *mRotation = &mUnboundRotation;
     /// Rotation source associated with pulley
     RotationSource mRotationSource;
     /// Left side of pulley hub image
@@ -60,19 +63,37 @@ public:
 
     /**
     * Draw the component at the currently specified location in the background.
-    * @param graphics Graphics object to render to
+    * @param list Display list to record the drawing into
     */
-    void DrawComponentBackground(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void DrawComponentBackground(DisplayList &list) const override;
     /**
     * Draw the component at the currently specified location in the foreground.
-    * @param graphics Graphics object to render to
+    * @param list Display list to record the drawing into
     */
-    void DrawComponentForeground(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void DrawComponentForeground(DisplayList &list) const override;
     /**
      * Reset this component
      */
     void Reset() override;
 
+    /**
+     * Move the pulley rotation into the machine's component store
+     * @param store Component store of the machine
+     */
+    void Bind(ComponentStore &store) override;
+
+    /**
+     * Save the simulation state of this component
+     * @param checkpoint Checkpoint to write the state to
+     */
+    void SaveState(Checkpoint &checkpoint) override;
+
+    /**
+     * Restore the simulation state of this component
+     * @param checkpoint Checkpoint to read the state from
+     */
+    void RestoreState(Checkpoint &checkpoint) override;
+
     /// Get a pointer to the source object
     /// @return Pointer to RotationSource object
     RotationSource* GetSource() { return &mRotationSource; }
@@ -85,6 +106,33 @@ public:
     */
     void UpdateRotation(double rotation) override;
 
+    /**
+     * Add this pulley alone to a compiled drive table.
+     * Its rotation is set directly from the table.
+     * @param table Drive table to add to
+     * @param multiplier Multiplier from the table source rotation to this pulley
+     */
+    void AddToTable(DriveTable &table, double multiplier) override;
+
+    /**
+     * Add this pulley and everything it drives to a compiled drive table.
+     * @param table Drive table to add to
+     * @param multiplier Multiplier from the table source rotation to this pulley
+     */
+    void Compile(DriveTable &table, double multiplier) override;
+
+    /**
+     * Set the source that drives this pulley
+     * @param driver Source driving this pulley
+     */
+    void SetDriver(RotationSource *driver) override { mRotationSource.SetDriver(driver); }
+
+    /**
+     * Get the speed of the belt connected pulley relative to this one
+     * @return Speed ratio between this pulley and the belt connected pulley
+     */
+    double BeltRatio();
+
     /**
      * Connect a pulley to another pulley
      * and setup the belt image.
@@ -97,7 +145,7 @@ public:
      * Used for setting up belt image
      * @return Length of pulley
      */
-    int GetDiameter() { return mPulleyDiameter; }
+    int GetDiameter() const { return mPulleyDiameter; }
 };
 
 
@@ -9,3 +9,65 @@
 RotationSource::RotationSource()
 {
 }
+
+/**
+ * Compile the drive graph below this source into a flat table.
+ * Must be called again if the graph changes. Does nothing if
+ * a precompiled table has been installed and the graph has not
+ * changed since.
+ */
+void RotationSource::Compile()
+{
+    if (mInstalled)
+    {
+        return;
+    }
+
+    mTable.Clear();
+    Compile(mTable, 1);
+    mCompiled = true;
+}
+
+/**
+ * Use a drive table built ahead of time for the graph below this
+ * source. The table is kept until the graph below the source changes.
+ * @param table Drive table for the graph below this source
+ */
+void RotationSource::Install(DriveTable table)
+{
+    mTable = std::move(table);
+    mCompiled = true;
+    mInstalled = true;
+}
+
+/**
+ * Discard the table of this source and of every source driving it.
+ *
+ * Called when the graph below this source changes. Until the root
+ * source is compiled again, rotation is passed on sink by sink.
+ */
+void RotationSource::Invalidate()
+{
+    for (auto source = this; source != nullptr; source = source->mDriver)
+    {
+        source->mCompiled = false;
+        source->mInstalled = false;
+    }
+}
+
+/**
+ * Add the sinks of this source to a drive table.
+ *
+ * The graph is walked depth first from the source, so every
+ * sink is added after the sink that drives it.
+ *
+ * @param table Drive table to add to
+ * @param multiplier Multiplier from the table source rotation to this source
+ */
+void RotationSource::Compile(DriveTable &table, double multiplier)
+{
+    for (const auto &sink : mSinks)
+    {
+        sink->Compile(table, multiplier);
+    }
+}
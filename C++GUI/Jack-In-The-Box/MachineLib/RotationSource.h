@@ -8,6 +8,7 @@
 #ifndef ROTATIONSOURCE_H
 #define ROTATIONSOURCE_H
 #include "IRotationSink.h"
+#include "DriveTable.h"
 
 class IRotationSink;
 
@@ -25,6 +26,18 @@ private:
     /// Rotation sinks receiving their rotation from this source
     std::vector<std::shared_ptr<IRotationSink>> mSinks;
 
+    /// Compiled drive graph below this source
+    DriveTable mTable;
+
+    /// True once the drive graph has been compiled
+    bool mCompiled = false;
+
+    /// True if the table was installed precompiled and must not be rebuilt
+    bool mInstalled = false;
+
+    /// Source driving the component this source belongs to, nullptr at the root
+    RotationSource *mDriver = nullptr;
+
 public:
     /**
      * Rotation source default constructor
@@ -44,7 +57,13 @@ public:
     void SetRotation(double rotation)
     {
         mSourceRotation = rotation;
-        for (auto sink : mSinks)
+        if (mCompiled)
+        {
+            mTable.Propagate(mSourceRotation);
+            return;
+        }
+
+        for (const auto &sink : mSinks)
         {
             sink->UpdateRotation(mSourceRotation);
         }
@@ -57,7 +76,23 @@ public:
     void AddSink(std::shared_ptr<IRotationSink> sink)
     {
         mSinks.push_back(sink);
+        sink->SetDriver(this);
+        Invalidate();
     }
+
+    /**
+     * Set the source driving the component this source belongs to
+     * @param driver Driving source
+     */
+    void SetDriver(RotationSource *driver) { mDriver = driver; }
+
+    void Invalidate();
+
+    void Compile();
+
+    void Install(DriveTable table);
+
+    void Compile(DriveTable &table, double multiplier);
 };
 
 
@@ -5,6 +5,7 @@
  */
 #include "pch.h"
 #include "Shaft.h"
+#include "DisplayList.h"
 
 /// The color to draw the shaft
 const wxColour ShaftColor = wxColour(220, 220, 220);
@@ -27,37 +28,61 @@ const int ShaftYOffset = -185;
 /// X offset for shaft placement
 const int ShaftXOffset = 90;
 
-/// Left center offset used for pulley placement
-const wxPoint ShaftLCOff = wxPoint(5, 2.5f);
-/// Right center offset used for pulley placement
-const wxPoint ShaftRCOff = wxPoint(20, 2.5f);
-
 Shaft::Shaft(int diameter, int length, wxPoint location) :  mRotationSource()
 {
     SetLocation(location);
     mCylinder.SetSize(diameter, length);
     mCylinder.SetColour(ShaftColor);
     mCylinder.SetLines(ShaftLineColor, ShaftLinesWidth, ShaftNumLines);
-    mLeftCenter = wxPoint( GetX() + ShaftLCOff.x, GetY() - ShaftLCOff.y );
-    mRightCenter = wxPoint( GetX() + (length - ShaftRCOff.x), GetY() - ShaftRCOff.y);
+    mLeftCenter = wxPoint( GetX() + ShaftLeftCenterX, GetY() - ShaftCenterY );
+    mRightCenter = wxPoint( GetX() + (length - ShaftRightCenterX), GetY() - ShaftCenterY);
 }
 
-void Shaft::DrawComponentBackground(std::shared_ptr<wxGraphicsContext> graphics)
+void Shaft::DrawComponentBackground(DisplayList &list) const
 {
-    mCylinder.Draw(graphics, GetX(), GetY(), mRotation);
+    list.DrawCylinder(mCylinder, GetX(), GetY(), *mRotation);
 }
 
-void Shaft::DrawComponentForeground(std::shared_ptr<wxGraphicsContext> graphics)
+void Shaft::DrawComponentForeground(DisplayList &list) const
 {
 }
 
 void Shaft::UpdateRotation(double rotation)
 {
-    mRotation = rotation;
-    mRotationSource.SetRotation(mRotation); // Set the rotation of the rotation source
+    *mRotation = rotation;
+    mRotationSource.SetRotation(*mRotation); // Set the rotation of the rotation source
 }
 
 void Shaft::Reset()
 {
-    mRotation = 0;
+    *mRotation = 0;
+}
+
+void Shaft::Bind(ComponentStore &store)
+{
+    Component::Bind(store);	// Upcall
+    mRotation = store.AddRotation(*mRotation);
+}
+
+void Shaft::SaveState(Checkpoint &checkpoint)
+{
+    Component::SaveState(checkpoint);	// Upcall
+    checkpoint.Write(*mRotation);
+}
+
+void Shaft::RestoreState(Checkpoint &checkpoint)
+{
+    Component::RestoreState(checkpoint);	// Upcall
+    *mRotation = checkpoint.Read();
+}
+
+void Shaft::AddToTable(DriveTable &table, double multiplier)
+{
+    table.AddRotation(mRotation, multiplier);
+}
+
+void Shaft::Compile(DriveTable &table, double multiplier)
+{
+    AddToTable(table, multiplier);
+    mRotationSource.Compile(table, multiplier);
 }
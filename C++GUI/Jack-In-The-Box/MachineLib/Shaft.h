@@ -14,11 +14,21 @@
 #include "RotationSource.h"
 
 /// Default diameter of the shaft cylinder
-const int ShaftDiameter = 10;
+constexpr int ShaftDiameter = 10;
 /// Default length of the shaft cylinder in pixels
-const int ShaftLength = 80;
+constexpr int ShaftLength = 80;
+/// Default X for shaft placement
+constexpr int ShaftDefaultX = 90;
+/// Default Y for shaft placement
+constexpr int ShaftDefaultY = -185;
 /// Default point for shaft placement
-const wxPoint DefaultPoint = wxPoint(90, -185);
+const wxPoint DefaultPoint = wxPoint(ShaftDefaultX, ShaftDefaultY);
+/// X offset from the shaft location to its left center. Used for pulley placement.
+constexpr int ShaftLeftCenterX = 5;
+/// X offset from the right end of the shaft back to its right center. Used for pulley placement.
+constexpr int ShaftRightCenterX = 20;
+/// Y offset from the shaft location up to its centers. Used for pulley placement.
+constexpr int ShaftCenterY = 2;
 
 /**
  * Class that represents a shaft component.
@@ -33,8 +43,11 @@ private:
     /// Rotation source associated with shaft
     RotationSource mRotationSource;
 
-    /// Rotation of the shaft
-    double mRotation = 0;
+    /// Rotation of the shaft while it is not part of a machine
+    double mUnboundRotation = 0;
+    /// Rotation of the shaft.
+    /// Points into the machine's component store once bound.
+    double *mRotation = &mUnboundRotation;
 
     /// Left center point of shaft. To be used by pulley for placement.
     wxPoint mLeftCenter;
@@ -60,14 +73,14 @@ public:
 
     /**
     * Draw the component at the currently specified location in the background.
-    * @param graphics Graphics object to render to
+    * @param list Display list to record the drawing into
     */
-    void DrawComponentBackground(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void DrawComponentBackground(DisplayList &list) const override;
     /**
     * Draw the component at the currently specified location in the foreground.
-    * @param graphics Graphics object to render to
+    * @param list Display list to record the drawing into
     */
-    void DrawComponentForeground(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void DrawComponentForeground(DisplayList &list) const override;
 
     /**
      * Updates the rotation of the shaft based on its source.
@@ -77,11 +90,50 @@ public:
      */
     void UpdateRotation(double rotation) override;
 
+    /**
+     * Add this shaft alone to a compiled drive table.
+     * Its rotation is set directly from the table.
+     * @param table Drive table to add to
+     * @param multiplier Multiplier from the table source rotation to this shaft
+     */
+    void AddToTable(DriveTable &table, double multiplier) override;
+
+    /**
+     * Add this shaft and everything it drives to a compiled drive table.
+     * @param table Drive table to add to
+     * @param multiplier Multiplier from the table source rotation to this shaft
+     */
+    void Compile(DriveTable &table, double multiplier) override;
+
+    /**
+     * Set the source that drives this shaft
+     * @param driver Source driving this shaft
+     */
+    void SetDriver(RotationSource *driver) override { mRotationSource.SetDriver(driver); }
+
     /**
      * Reset this component
      */
     void Reset() override;
 
+    /**
+     * Move the shaft rotation into the machine's component store
+     * @param store Component store of the machine
+     */
+    void Bind(ComponentStore &store) override;
+
+    /**
+     * Save the simulation state of this component
+     * @param checkpoint Checkpoint to write the state to
+     */
+    void SaveState(Checkpoint &checkpoint) override;
+
+    /**
+     * Restore the simulation state of this component
+     * @param checkpoint Checkpoint to read the state from
+     */
+    void RestoreState(Checkpoint &checkpoint) override;
+
     /// Get a pointer to the source object
     /// @return Pointer to RotationSource object
     RotationSource* GetSource() { return &mRotationSource; }
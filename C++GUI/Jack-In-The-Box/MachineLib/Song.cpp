@@ -0,0 +1,417 @@
+/**
+ * @file Song.cpp
+ * @author Jaylon Sifuentes
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+#include <wx/xml/xml.h>
+#include "Song.h"
+#include "XmlStreamReader.h"
+
+/// Extension of binary song files
+const std::wstring BinaryExtension = L".song";
+
+/// Identifies a binary song file
+const char BinaryMagic[4] = {'S', 'O', 'N', 'G'};
+
+/// Version of the binary song format
+const uint32_t BinaryVersion = 1;
+
+/// Written in host byte order so files from a host of the other order are rejected
+const uint32_t BinaryByteOrder = 0x01020304;
+
+/**
+ * Header at the start of a binary song file.
+ *
+ * The header is followed by the note array, then a
+ * BinarySound for each note id, then the UTF-8 sound
+ * file names the BinarySound entries point into.
+ */
+struct BinaryHeader
+{
+    /// BinaryMagic
+    char mMagic[4];
+    /// BinaryVersion
+    uint32_t mVersion;
+    /// BinaryByteOrder
+    uint32_t mByteOrder;
+    /// Beats per measure
+    int32_t mBeatsPerMeasure;
+    /// Number of note ids
+    uint32_t mSoundCount;
+    /// Number of notes
+    uint32_t mNoteCount;
+};
+
+/**
+ * Sound file of a note id in a binary song file
+ */
+struct BinarySound
+{
+    /// Offset of the file name from the start of the file
+    uint32_t mOffset;
+    /// Length of the file name in bytes
+    uint32_t mLength;
+};
+
+// The note array is used in place, so its layout is part of the format
+static_assert(sizeof(Song::Note) == 8 && alignof(Song::Note) <= 4, "Song::Note layout changed");
+static_assert(sizeof(BinaryHeader) % alignof(Song::Note) == 0, "Note array must be aligned");
+
+/**
+ * Convert UTF-8 text from the XML reader to a wide string
+ * @param text UTF-8 text
+ * @return Wide string
+ */
+static std::wstring Widen(const std::string &text)
+{
+    return wxString::FromUTF8(text.c_str(), text.size()).ToStdWstring();
+}
+
+/**
+ * Parse a number from the song file. The decimal separator
+ * is always '.', whatever the current locale uses.
+ * @param text Text of the number
+ * @return The number, or zero if the text is not a number
+ */
+static double ParseDouble(const wxString &text)
+{
+    double value = 0;
+    if (!text.ToCDouble(&value))
+    {
+        return 0;
+    }
+
+    return value;
+}
+
+/**
+ * Get the id of a note name, giving it the next id if it is new
+ * @param name Note name
+ * @return Note id
+ */
+uint16_t Song::NoteId(const std::wstring &name)
+{
+    auto id = mNoteIds.find(name);
+    if (id == mNoteIds.end())
+    {
+        id = mNoteIds.emplace(name, (uint16_t)mSoundFiles.size()).first;
+        mSoundFiles.emplace_back();
+    }
+
+    return id->second;
+}
+
+/**
+ * Add a sound to the song
+ * @param name Note name
+ * @param file Sound file, relative to the audio directory
+ */
+void Song::AddSound(const std::wstring &name, const std::wstring &file)
+{
+    mSoundFiles[NoteId(name)] = file;
+}
+
+/**
+ * Add a note to the song
+ * @param name Note name
+ * @param measure Measure, starting at 1
+ * @param beat Beat within the measure, starting at 1
+ */
+void Song::AddNote(const std::wstring &name, int measure, double beat)
+{
+    // Absolute beat equation
+    double absoluteBeat = (measure - 1) * mBeatsPerMeasure + (beat - 1);
+    mNotes.push_back({NoteId(name), (float)absoluteBeat});
+}
+
+/**
+ * Remove everything from the song
+ */
+void Song::Clear()
+{
+    mBeatsPerMeasure = 0;
+    mSoundFiles.clear();
+    mNoteIds.clear();
+    mNotes.clear();
+    mFile.Close();
+    mNoteData = nullptr;
+    mNoteCount = 0;
+}
+
+/**
+ * Finish loading the song
+ */
+void Song::Finish()
+{
+    // Keep the notes in beat order so they can be found by binary search
+    std::stable_sort(mNotes.begin(), mNotes.end(), [](const Note &a, const Note &b) {
+        return a.mBeat < b.mBeat;
+    });
+
+    mNoteData = mNotes.data();
+    mNoteCount = mNotes.size();
+}
+
+/**
+ * Get the binary song file that goes with an XML song file
+ * @param xmlPath xml file path for song
+ * @return Path of the binary song file
+ */
+std::wstring Song::BinaryPath(const std::wstring &xmlPath)
+{
+    auto dot = xmlPath.find_last_of(L'.');
+    auto slash = xmlPath.find_last_of(L"/\\");
+    if (dot == std::wstring::npos || (slash != std::wstring::npos && dot < slash))
+    {
+        return xmlPath + BinaryExtension;
+    }
+
+    return xmlPath.substr(0, dot) + BinaryExtension;
+}
+
+/**
+ * Load a song, using its binary form if there is one that
+ * is at least as new as the XML file.
+ * @param xmlPath xml file path for song
+ * @return true if the song could be loaded
+ */
+bool Song::Open(const std::wstring &xmlPath)
+{
+    std::wstring binaryPath = BinaryPath(xmlPath);
+    if (wxFileExists(binaryPath) &&
+        (!wxFileExists(xmlPath) || wxFileModificationTime(binaryPath) >= wxFileModificationTime(xmlPath)) &&
+        LoadBinary(binaryPath))
+    {
+        return true;
+    }
+
+    return Load(xmlPath);
+}
+
+/**
+ * Load the song from a binary song file.
+ *
+ * The file is mapped and its note array is used in place.
+ * Only the sound file names, one per note id, are copied.
+ *
+ * @param path Binary song file
+ * @return true if the file is a valid binary song
+ */
+bool Song::LoadBinary(const std::wstring &path)
+{
+    Clear();
+    if (!mFile.Open(path) || mFile.GetSize() < sizeof(BinaryHeader))
+    {
+        Clear();
+        return false;
+    }
+
+    const char *data = mFile.GetData();
+    size_t size = mFile.GetSize();
+    BinaryHeader header;
+    memcpy(&header, data, sizeof(header));
+
+    size_t notesSize = (size_t)header.mNoteCount * sizeof(Note);
+    size_t soundsSize = (size_t)header.mSoundCount * sizeof(BinarySound);
+    if (memcmp(header.mMagic, BinaryMagic, sizeof(BinaryMagic)) != 0 || header.mVersion != BinaryVersion ||
+        header.mByteOrder != BinaryByteOrder || sizeof(header) + notesSize + soundsSize > size)
+    {
+        Clear();
+        return false;
+    }
+
+    // Validate once here so the notes can be used without checks
+    const Note *notes = (const Note *)(data + sizeof(header));
+    for (size_t i = 0; i < header.mNoteCount; i++)
+    {
+        if (notes[i].mSound >= header.mSoundCount || (i > 0 && notes[i].mBeat < notes[i - 1].mBeat))
+        {
+            Clear();
+            return false;
+        }
+    }
+
+    const char *sounds = data + sizeof(header) + notesSize;
+    for (size_t i = 0; i < header.mSoundCount; i++)
+    {
+        BinarySound sound;
+        memcpy(&sound, sounds + i * sizeof(BinarySound), sizeof(sound));
+        if ((size_t)sound.mOffset + sound.mLength > size)
+        {
+            Clear();
+            return false;
+        }
+
+        mSoundFiles.push_back(Widen(std::string(data + sound.mOffset, sound.mLength)));
+    }
+
+    mBeatsPerMeasure = header.mBeatsPerMeasure;
+    mNoteData = notes;
+    mNoteCount = header.mNoteCount;
+    return true;
+}
+
+/**
+ * Save the song as a binary song file
+ * @param path File to write
+ * @return true if successful
+ */
+bool Song::SaveBinary(const std::wstring &path) const
+{
+    BinaryHeader header;
+    memcpy(header.mMagic, BinaryMagic, sizeof(BinaryMagic));
+    header.mVersion = BinaryVersion;
+    header.mByteOrder = BinaryByteOrder;
+    header.mBeatsPerMeasure = mBeatsPerMeasure;
+    header.mSoundCount = (uint32_t)mSoundFiles.size();
+    header.mNoteCount = (uint32_t)mNoteCount;
+
+    // Notes are written field by field so the padding is always zero
+    std::vector<char> notes(mNoteCount * sizeof(Note));
+    for (size_t i = 0; i < mNoteCount; i++)
+    {
+        memcpy(notes.data() + i * sizeof(Note) + offsetof(Note, mSound), &mNoteData[i].mSound, sizeof(uint16_t));
+        memcpy(notes.data() + i * sizeof(Note) + offsetof(Note, mBeat), &mNoteData[i].mBeat, sizeof(float));
+    }
+
+    std::vector<BinarySound> sounds;
+    std::string names;
+    size_t namesOffset = sizeof(header) + mNoteCount * sizeof(Note) + mSoundFiles.size() * sizeof(BinarySound);
+    for (auto &file : mSoundFiles)
+    {
+        std::string name = wxString(file).utf8_string();
+        sounds.push_back({(uint32_t)(namesOffset + names.size()), (uint32_t)name.size()});
+        names += name;
+    }
+
+    // Prevent error popup from wxWidgets
+    wxLogNull logNo;
+
+    wxFFile file;
+    if (!file.Open(path, "wb"))
+    {
+        return false;
+    }
+
+    bool ok = file.Write(&header, sizeof(header)) == sizeof(header);
+    ok = ok && file.Write(notes.data(), notes.size()) == notes.size();
+    ok = ok && file.Write(sounds.data(), sounds.size() * sizeof(BinarySound)) == sounds.size() * sizeof(BinarySound);
+    ok = ok && file.Write(names.data(), names.size()) == names.size();
+    return file.Close() && ok;
+}
+
+/**
+ * Load the song from an XML file in a single forward pass.
+ *
+ * The file is streamed, so memory use only depends
+ * on the number of notes, not the size of the file.
+ *
+ * @param xmlPath xml file path for song
+ * @return true if the file could be read
+ */
+bool Song::Load(const std::wstring &xmlPath)
+{
+    Clear();
+
+    XmlStreamReader reader;
+    if (!reader.Open(xmlPath))
+    {
+        return false;
+    }
+
+    while (reader.Next())
+    {
+        auto &name = reader.GetName();
+        if (name == "song")
+        {
+            mBeatsPerMeasure = std::atoi(reader.GetAttribute("beats").c_str());
+        }
+        else if (name == "sound")
+        {
+            AddSound(Widen(reader.GetAttribute("note")), Widen(reader.GetAttribute("file")));
+        }
+        else if (name == "note")
+        {
+            AddNote(Widen(reader.GetAttribute("note")),
+                    std::atoi(reader.GetAttribute("measure").c_str()),
+                    ParseDouble(Widen(reader.GetAttribute("beat"))));
+        }
+    }
+
+    Finish();
+    return true;
+}
+
+/**
+ * Load the song by building the XML document in memory.
+ * Kept to compare with Load.
+ * @param xmlPath xml file path for song
+ * @return true if the file could be read
+ */
+bool Song::LoadDom(const std::wstring &xmlPath)
+{
+    Clear();
+
+    wxXmlDocument notesXml;
+    if (!notesXml.Load(xmlPath))
+    {
+        return false;
+    }
+
+    wxXmlNode* root = notesXml.GetRoot();
+    mBeatsPerMeasure = wxAtoi(root->GetAttribute("beats"));
+
+    /*
+     * Gather all the sounds
+     */
+    wxXmlNode* soundsSection = root->GetChildren();
+    while (soundsSection)
+    {
+        if (soundsSection->GetName() == "sounds")
+        {
+            wxXmlNode* soundLine = soundsSection->GetChildren();
+            while (soundLine)
+            {
+                if (soundLine->GetName() == "sound")
+                {
+                    AddSound(soundLine->GetAttribute(L"note").ToStdWstring(),
+                             soundLine->GetAttribute("file").ToStdWstring());
+                }
+                soundLine = soundLine->GetNext();
+            }
+        }
+        soundsSection = soundsSection->GetNext();
+    }
+
+    /*
+     * Gather all the notes
+     */
+    wxXmlNode* notesSection = root->GetChildren();
+    while (notesSection)
+    {
+        if (notesSection->GetName() == "notes")
+        {
+            wxXmlNode* noteLine = notesSection->GetChildren();
+            while (noteLine)
+            {
+                if (noteLine->GetName() == "note")
+                {
+                    AddNote(noteLine->GetAttribute("note").ToStdWstring(),
+                            wxAtoi(noteLine->GetAttribute("measure")),
+                            ParseDouble(noteLine->GetAttribute("beat")));
+                }
+                noteLine = noteLine->GetNext();
+            }
+        }
+        notesSection = notesSection->GetNext();
+    }
+
+    Finish();
+    return true;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file Song.h
+ * @author Jaylon Sifuentes
+ *
+ * Class that represents a song loaded from an XML file.
+ */
+
+#ifndef SONG_H
+#define SONG_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+
+/**
+ * A song played by the music box.
+ *
+ * Each note name is given an integer id, its index in the
+ * list of sound files, and the notes are kept in beat order.
+ *
+ * A song can be saved in a binary form that holds the notes
+ * exactly as they are in memory. Loading the binary form maps
+ * the file and uses its note array in place.
+ */
+class Song
+{
+public:
+    /// A note in the song
+    struct Note
+    {
+        /// Id of the note's sound
+        uint16_t mSound;
+        /// Absolute beat the note is played on
+        float mBeat;
+    };
+
+private:
+    /// Beats per measure at top of XML
+    int mBeatsPerMeasure = 0;
+
+    /// Sound file for each note id. Empty if the song has none.
+    std::vector<std::wstring> mSoundFiles;
+
+    /// Id of each note name
+    std::map<std::wstring, uint16_t> mNoteIds;
+
+    /// The notes, sorted by beat, when loaded from XML
+    std::vector<Note> mNotes;
+
+    /// The binary song file, when loaded from one
+    MappedFile mFile;
+
+    /// The notes, in mNotes or mFile
+    const Note *mNoteData = nullptr;
+
+    /// Number of notes
+    size_t mNoteCount = 0;
+
+    uint16_t NoteId(const std::wstring &name);
+    void AddSound(const std::wstring &name, const std::wstring &file);
+    void AddNote(const std::wstring &name, int measure, double beat);
+    void Clear();
+    void Finish();
+
+public:
+    Song() = default;
+
+    /// Copy constructor (disabled)
+    Song(const Song &) = delete;
+
+    /// Assignment operator (disabled)
+    void operator=(const Song &) = delete;
+
+    bool Open(const std::wstring &xmlPath);
+
+    bool Load(const std::wstring &xmlPath);
+
+    bool LoadBinary(const std::wstring &path);
+
+    bool SaveBinary(const std::wstring &path) const;
+
+    static std::wstring BinaryPath(const std::wstring &xmlPath);
+
+    bool LoadDom(const std::wstring &xmlPath);
+
+    /**
+     * Get the number of beats per measure
+     * @return Beats per measure
+     */
+    int GetBeatsPerMeasure() const { return mBeatsPerMeasure; }
+
+    /**
+     * Get the sound file of each note id
+     * @return Sound file names, relative to the audio directory
+     */
+    const std::vector<std::wstring> &GetSoundFiles() const { return mSoundFiles; }
+
+    /**
+     * Get the notes of the song
+     * @return Array of GetNoteCount() notes sorted by beat
+     */
+    const Note *GetNotes() const { return mNoteData; }
+
+    /**
+     * Get the number of notes in the song
+     * @return Number of notes
+     */
+    size_t GetNoteCount() const { return mNoteCount; }
+};
+
+
+#endif //SONG_H
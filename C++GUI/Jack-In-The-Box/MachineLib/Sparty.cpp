@@ -5,6 +5,7 @@
 
 #include "pch.h"
 #include "Sparty.h"
+#include "DisplayList.h"
 
 /// The spring pen size to use in pixels
 const double SpringWireSize = 2;
@@ -43,23 +44,30 @@ Sparty::Sparty(std::wstring imagesDir, int size, int springLength, int springWid
 
 }
 
+void Sparty::Bind(ComponentStore &store)
+{
+    Component::Bind(store);	// Upcall
+    store.AddAnimated(this);
+}
+
 void Sparty::Reset()
 {
     mSpringIncrease = 0;
     mIsSprung = false;
+    mBounceTime = 0;
 }
 
-void Sparty::DrawComponentBackground(std::shared_ptr<wxGraphicsContext> graphics)
+void Sparty::DrawComponentBackground(DisplayList &list) const
 {
     // Draw consistently
-    DrawSpring(graphics, mSpringX, 0, mSpringStartLength + mSpringIncrease, mSpringWidth, mSpringLinks - mSpringIncrease / LinkSeperationDiv);
+    DrawSpring(list, mSpringX, 0, mSpringStartLength + mSpringIncrease, mSpringWidth, mSpringLinks - mSpringIncrease / LinkSeperationDiv);
     // If this is not a bouncy toy or a toy that hasnt been sprung up, position accordingly.
     if(!mIsSprung || !mBouncyToy)
     {
-        graphics->PushState();
-        graphics->Translate( mSpringX, (mSpringStartLength - mSpringIncrease));
-        mSparty.DrawPolygon(graphics, 0, 0);
-        graphics->PopState();
+        list.PushState();
+        list.Translate( mSpringX, (mSpringStartLength - mSpringIncrease));
+        list.DrawPolygon(mSparty, 0, 0);
+        list.PopState();
     }
 
     // If this is a bouncy toy, make it bounce once sprung is triggered.
@@ -67,30 +75,29 @@ void Sparty::DrawComponentBackground(std::shared_ptr<wxGraphicsContext> graphics
     {
         double yBounceOff = BounceHeight * sin(mBounceTime * BounceSpeed);
         double xBounceOff = BounceWidth * sin(mBounceTime * BounceSpeed / 2);  // Adding a phase shift
-        graphics->PushState();
-        graphics->Translate(mSpringX + xBounceOff, (mSpringStartLength - mSpringIncrease) + yBounceOff);  // Apply yOffset based on mSpringIncrease
-        mSparty.DrawPolygon(graphics, 0, 0);
-        graphics->PopState();
+        list.PushState();
+        list.Translate(mSpringX + xBounceOff, (mSpringStartLength - mSpringIncrease) + yBounceOff);  // Apply yOffset based on mSpringIncrease
+        list.DrawPolygon(mSparty, 0, 0);
+        list.PopState();
     }
 }
 
-void Sparty::DrawComponentForeground(std::shared_ptr<wxGraphicsContext> graphics)
+void Sparty::DrawComponentForeground(DisplayList &list) const
 {
 }
 
 /**
  * Draw a spring.
- * @param graphics Graphics context to render to
+ * @param list Display list to record the drawing into
  * @param x X location of the bottom center of the spring in pixels
  * @param y Y location of the bottom center of the spring in pixels
  * @param length Length to draw the spring (bottom to top) in pixels
  * @param width Spring width in pixels
  * @param numLinks Number of links (loops) in the spring
  */
-void Sparty::DrawSpring(std::shared_ptr<wxGraphicsContext> graphics,
-                        int x, int y, double length, double width, int numLinks)
+void Sparty::DrawSpring(DisplayList &list,
+                        int x, int y, double length, double width, int numLinks) const
 {
-    auto path = graphics->CreatePath();
     // We keep track of three locations, the bottom of which
     // is y1. First half-loop will be y1 to y3, second half-loop
     // will be y3 to y2.
@@ -99,21 +106,36 @@ void Sparty::DrawSpring(std::shared_ptr<wxGraphicsContext> graphics,
     // Left and right X values
     double xR = x + width / 2;
     double xL = x - width / 2;
-    path.MoveToPoint(x, y1);
+    list.MoveToPoint(x, y1);
     for(int i=0; i<numLinks; i++)
     {
         auto y2 = y1 - linkLength;
         auto y3 = y2 - linkLength / 2;
-        path.AddCurveToPoint(xR, y1, xR, y3, x, y3);
-        path.AddCurveToPoint(xL, y3, xL, y2, x, y2);
+        list.AddCurveToPoint(xR, y1, xR, y3, x, y3);
+        list.AddCurveToPoint(xL, y3, xL, y2, x, y2);
         y1 = y2;
     }
-    graphics->StrokePath(path);
+    list.StrokePath();
 }
 
-void Sparty::OnKeyDrop()
+void Sparty::OnKeyDrop(double time)
 {
+    if(mIsSprung)
+    {
+        return;
+    }
+
     mIsSprung = true;
+
+    // If the key dropped in the past (seeking), the spring is already partly extended
+    double elapsed = GetTime() - time;
+    mSpringIncrease = std::min(mSpringStartLength * MaxSpringLengthMult,
+                               std::max(0.0, SpringSpeed * elapsed / SpartyPopupTime));
+}
+
+void Sparty::Seek(double time)
+{
+    mBounceTime = time;
 }
 
 /**
@@ -147,8 +169,18 @@ void Sparty::Advance(double increase)
     mBounceTime += increase;
 }
 
+void Sparty::SaveState(Checkpoint &checkpoint)
+{
+    Component::SaveState(checkpoint);	// Upcall
+    checkpoint.Write(mIsSprung);
+    checkpoint.Write(mSpringIncrease);
+    checkpoint.Write(mBounceTime);
+}
 
-
-
-
-
+void Sparty::RestoreState(Checkpoint &checkpoint)
+{
+    Component::RestoreState(checkpoint);	// Upcall
+    mIsSprung = checkpoint.Read() != 0;
+    mSpringIncrease = checkpoint.Read();
+    mBounceTime = checkpoint.Read();
+}
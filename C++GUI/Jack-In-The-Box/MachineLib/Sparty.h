@@ -55,25 +55,50 @@ public:
      */
     void Reset() override;
 
+    /**
+     * Add Sparty to the animated components of the machine's component store
+     * @param store Component store of the machine
+     */
+    void Bind(ComponentStore &store) override;
+
+    /**
+     * Save the simulation state of this component
+     * @param checkpoint Checkpoint to write the state to
+     */
+    void SaveState(Checkpoint &checkpoint) override;
+
+    /**
+     * Restore the simulation state of this component
+     * @param checkpoint Checkpoint to read the state from
+     */
+    void RestoreState(Checkpoint &checkpoint) override;
+
     void Advance(double increase) override;
+
+    /**
+     * Set the bounce animation directly from the machine time
+     * @param time Machine time in seconds
+     */
+    void Seek(double time) override;
     /**
    * Draw the component at the currently specified location in the background.
-   * @param graphics Graphics object to render to
+   * @param list Display list to record the drawing into
    */
-    void DrawComponentBackground(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void DrawComponentBackground(DisplayList &list) const override;
     /**
     * Draw the component at the currently specified location in the background.
-    * @param graphics Graphics object to render to
+    * @param list Display list to record the drawing into
     */
-    void DrawComponentForeground(std::shared_ptr<wxGraphicsContext> graphics) override;
+    void DrawComponentForeground(DisplayList &list) const override;
 
-    void DrawSpring(std::shared_ptr<wxGraphicsContext> graphics, int x, int y, double length, double width,
-                    int numLinks);
+    void DrawSpring(DisplayList &list, int x, int y, double length, double width,
+                    int numLinks) const;
     /**
      * When called by Cam, this function triggers Sparty
      * to spring out of the box.
+     * @param time Machine time in seconds at which the key dropped
      */
-    void OnKeyDrop() override;
+    void OnKeyDrop(double time) override;
 };
 
 
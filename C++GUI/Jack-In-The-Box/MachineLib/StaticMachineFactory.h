@@ -0,0 +1,183 @@
+/**
+ * @file StaticMachineFactory.h
+ * @author Jaylon Sifuentes
+ *
+ * Factory that creates machines from compile time definitions.
+ */
+
+#ifndef STATICMACHINEFACTORY_H
+#define STATICMACHINEFACTORY_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "MachineDefinition.h"
+#include "Machine.h"
+#include "Box.h"
+#include "Cam.h"
+#include "Crank.h"
+#include "MusicBox.h"
+#include "Pulley.h"
+#include "Sparty.h"
+
+/**
+ * Factory that creates machines from compile time definitions.
+ *
+ * The definition is a constexpr array of parts and an array of
+ * links between them. It is checked when the factory is compiled.
+ * The location of every part and the drive table of every crank,
+ * with the belt ratios folded in, are also worked out by the
+ * compiler. Creating a machine only builds the components, links
+ * them and installs the drive tables, so the graph is never walked.
+ *
+ * @tparam Parts constexpr std::array of MachinePart
+ * @tparam Links constexpr std::array of MachineLink
+ */
+template<const auto &Parts, const auto &Links>
+class StaticMachineFactory
+{
+private:
+    /// Number of parts
+    static constexpr size_t PartCount = Parts.size();
+
+    static_assert(ValidMachine(Parts, Links), "Invalid machine definition");
+
+    /// Location of every part
+    static constexpr auto Locations = PartLocations(Parts);
+
+    /// Drive table of every crank
+    static constexpr auto Plan = PlanDrives(Parts, Links);
+
+public:
+    /**
+     * Create a machine
+     * @param resourcesDir Path to the resources directory
+     * @return Pointer to created machine
+     */
+    static std::shared_ptr<Machine> Create(const std::wstring &resourcesDir)
+    {
+        std::wstring imagesDir = resourcesDir + L"/images";
+        auto machine = std::make_shared<Machine>();
+
+        std::vector<RotationSource *> sources(PartCount);
+        std::vector<std::shared_ptr<IRotationSink>> sinks(PartCount);
+        std::vector<std::shared_ptr<IKeyResponder>> responders(PartCount);
+        std::vector<std::shared_ptr<Pulley>> pulleys(PartCount);
+        std::vector<std::shared_ptr<Cam>> cams(PartCount);
+
+        for (size_t i = 0; i < PartCount; i++)
+        {
+            auto &part = Parts[i];
+            wxPoint location(Locations[i].mX, Locations[i].mY);
+
+            std::shared_ptr<Component> component;
+            switch (part.mType)
+            {
+            case PartType::Box:
+            {
+                auto box = machine->Create<Box>(imagesDir, part.mBoxSize, part.mLidSize);
+                responders[i] = box;
+                component = box;
+                break;
+            }
+
+            case PartType::Sparty:
+            {
+                auto sparty = machine->Create<Sparty>(imagesDir + part.mFile, part.mSize, part.mSpringLength,
+                                                       part.mSpringWidth, part.mLinks, part.mBouncy, part.mSpringX);
+                responders[i] = sparty;
+                component = sparty;
+                break;
+            }
+
+            case PartType::Crank:
+            {
+                auto crank = machine->Create<Crank>(location);
+                sources[i] = crank->GetSource();
+                component = crank;
+                break;
+            }
+
+            case PartType::Shaft:
+            {
+                auto shaft = machine->Create<Shaft>(part.mDiameter, part.mLength, location);
+                sources[i] = shaft->GetSource();
+                sinks[i] = shaft;
+                component = shaft;
+                break;
+            }
+
+            case PartType::Pulley:
+            {
+                auto pulley = machine->Create<Pulley>(part.mDiameter, location);
+                sources[i] = pulley->GetSource();
+                sinks[i] = pulley;
+                pulleys[i] = pulley;
+                component = pulley;
+                break;
+            }
+
+            case PartType::Cam:
+            {
+                auto cam = machine->Create<Cam>(imagesDir, location);
+                sinks[i] = cam;
+                cams[i] = cam;
+                component = cam;
+                break;
+            }
+
+            case PartType::MusicBox:
+            {
+                auto music = machine->Create<MusicBox>(resourcesDir, part.mFile);
+                sinks[i] = music;
+                component = music;
+                break;
+            }
+            }
+
+            machine->AddComponent(component);
+        }
+
+        for (auto &link : Links)
+        {
+            switch (link.mType)
+            {
+            case LinkType::Drive:
+                sources[link.mFrom]->AddSink(sinks[link.mTo]);
+                break;
+
+            case LinkType::Belt:
+                pulleys[link.mFrom]->BeltTo(pulleys[link.mTo]);
+                break;
+
+            case LinkType::Responder:
+                cams[link.mFrom]->AddResponder(responders[link.mTo]);
+                break;
+            }
+        }
+
+        // Install the precompiled drive table of each crank
+        for (size_t i = 0; i < PartCount; i++)
+        {
+            if (Parts[i].mType != PartType::Crank)
+            {
+                continue;
+            }
+
+            DriveTable table;
+            for (size_t e = 0; e < Plan.mCount; e++)
+            {
+                if (Plan.mCrank[e] == (int)i)
+                {
+                    sinks[Plan.mPart[e]]->AddToTable(table, Plan.mMultiplier[e]);
+                }
+            }
+            sources[i]->Install(std::move(table));
+        }
+
+        return machine;
+    }
+};
+
+
+#endif //STATICMACHINEFACTORY_H
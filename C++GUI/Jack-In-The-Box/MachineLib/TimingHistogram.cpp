@@ -0,0 +1,94 @@
+/**
+ * @file TimingHistogram.cpp
+ * @author Jaylon Sifuentes
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include <cmath>
+#include "TimingHistogram.h"
+
+/**
+ * Get the bucket a timing belongs in
+ * @param nanoseconds Timing in nanoseconds
+ * @return Bucket index
+ */
+int TimingHistogram::Bucket(double nanoseconds)
+{
+    if (nanoseconds < 2)
+    {
+        return 0;
+    }
+
+    return std::min(BucketCount - 1, (int)std::log2(nanoseconds));
+}
+
+/**
+ * Add a timing, rolling the oldest one out if the window is full
+ * @param nanoseconds Timing in nanoseconds
+ */
+void TimingHistogram::Add(double nanoseconds)
+{
+    if (mWindow.size() < WindowSize)
+    {
+        mWindow.push_back(nanoseconds);
+    }
+    else
+    {
+        double &oldest = mWindow[mNext];
+        mBuckets[Bucket(oldest)]--;
+        mSum -= oldest;
+        oldest = nanoseconds;
+    }
+
+    mNext = (mNext + 1) % WindowSize;
+    mBuckets[Bucket(nanoseconds)]++;
+    mSum += nanoseconds;
+}
+
+/**
+ * Get the longest timing in the window
+ * @return Longest timing in nanoseconds, or 0 if there are none
+ */
+double TimingHistogram::GetMax() const
+{
+    return mWindow.empty() ? 0 : *std::max_element(mWindow.begin(), mWindow.end());
+}
+
+/**
+ * Estimate a percentile of the timings in the window from the buckets
+ * @param percentile Percentile from 0 to 100
+ * @return Upper bound of the bucket the percentile falls in, in nanoseconds
+ */
+double TimingHistogram::GetPercentile(double percentile) const
+{
+    size_t count = mWindow.size();
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    double rank = std::ceil(count * percentile / 100);
+    double seen = 0;
+    for (int bucket = 0; bucket < BucketCount - 1; bucket++)
+    {
+        seen += mBuckets[bucket];
+        if (seen >= rank)
+        {
+            return BucketStart(bucket + 1);
+        }
+    }
+
+    return GetMax();
+}
+
+/**
+ * Remove all timings
+ */
+void TimingHistogram::Clear()
+{
+    mBuckets = {};
+    mWindow.clear();
+    mNext = 0;
+    mSum = 0;
+}
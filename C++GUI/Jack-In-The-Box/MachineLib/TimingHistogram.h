@@ -0,0 +1,84 @@
+/**
+ * @file TimingHistogram.h
+ * @author Jaylon Sifuentes
+ *
+ * Class that keeps a rolling histogram of timings.
+ */
+
+#ifndef TIMINGHISTOGRAM_H
+#define TIMINGHISTOGRAM_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A histogram of the most recent timings.
+ *
+ * Timings are put in power of two nanosecond buckets, so bucket b
+ * counts timings from 2^b up to 2^(b+1) nanoseconds. Bucket 0 counts
+ * everything under 2 nanoseconds, including zero. Only the last
+ * WindowSize timings are counted; older ones roll out as new ones
+ * are added.
+ */
+class TimingHistogram
+{
+public:
+    /// Number of buckets. The last bucket counts everything longer.
+    static constexpr int BucketCount = 32;
+
+    /// Number of recent timings the histogram covers
+    static constexpr int WindowSize = 4096;
+
+private:
+    /// Count of timings in each bucket
+    std::array<uint32_t, BucketCount> mBuckets = {};
+
+    /// The most recent timings in nanoseconds, in a ring
+    std::vector<double> mWindow;
+
+    /// Next position to write in the ring
+    size_t mNext = 0;
+
+    /// Sum of the timings in the window in nanoseconds
+    double mSum = 0;
+
+    static int Bucket(double nanoseconds);
+
+public:
+    void Add(double nanoseconds);
+
+    /**
+     * Get the number of timings in the window
+     * @return Number of timings
+     */
+    size_t GetCount() const { return mWindow.size(); }
+
+    /**
+     * Get the mean of the timings in the window
+     * @return Mean in nanoseconds, or 0 if there are none
+     */
+    double GetMean() const { return mWindow.empty() ? 0 : mSum / mWindow.size(); }
+
+    double GetMax() const;
+
+    double GetPercentile(double percentile) const;
+
+    /**
+     * Get the count of timings in each bucket
+     * @return Bucket counts
+     */
+    const std::array<uint32_t, BucketCount> &GetBuckets() const { return mBuckets; }
+
+    /**
+     * Get the shortest timing counted by a bucket
+     * @param bucket Bucket index
+     * @return Lower bound of the bucket in nanoseconds
+     */
+    static double BucketStart(int bucket) { return bucket == 0 ? 0 : double(uint64_t(1) << bucket); }
+
+    void Clear();
+};
+
+
+#endif //TIMINGHISTOGRAM_H
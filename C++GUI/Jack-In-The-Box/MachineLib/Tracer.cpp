@@ -0,0 +1,203 @@
+/**
+ * @file Tracer.cpp
+ * @author Jaylon Sifuentes
+ */
+
+#include "pch.h"
+#include "Tracer.h"
+#include "ComponentProfiler.h"
+
+/// How often the flusher drains the buffers
+const auto FlushInterval = std::chrono::milliseconds(50);
+
+/**
+ * Get the tracer
+ * @return The single tracer
+ */
+Tracer &Tracer::Instance()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+/**
+ * Get the buffer of the calling thread, creating it on first use
+ * @return Buffer of the calling thread
+ */
+Tracer::ThreadBuffer &Tracer::Buffer()
+{
+    thread_local ThreadBuffer *buffer = nullptr;
+    if (buffer == nullptr)
+    {
+        // The tracer keeps the buffer so spans survive the thread exiting
+        auto &tracer = Instance();
+        std::lock_guard<std::mutex> lock(tracer.mMutex);
+        auto created = std::make_shared<ThreadBuffer>();
+        created->mThread = (int)tracer.mBuffers.size() + 1;
+        tracer.mBuffers.push_back(created);
+        buffer = created.get();
+    }
+
+    return *buffer;
+}
+
+/**
+ * Record a span into the calling thread's buffer
+ * @param event Span to record
+ */
+void Tracer::Record(const Event &event)
+{
+    auto &buffer = Buffer();
+    if (!buffer.mEvents.Push(event))
+    {
+        buffer.mDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Start tracing to a file
+ * @param filename Trace file to write
+ * @return false if the file cannot be written or tracing is already running
+ */
+bool Tracer::Start(const std::string &filename)
+{
+    auto &tracer = Instance();
+    std::unique_lock<std::mutex> lock(tracer.mMutex);
+    if (IsEnabled())
+    {
+        return false;
+    }
+
+    tracer.mFile.open(filename);
+    if (!tracer.mFile)
+    {
+        return false;
+    }
+
+    // Discard anything recorded after the last trace stopped
+    Event event;
+    for (auto &buffer : tracer.mBuffers)
+    {
+        while (buffer->mEvents.Pop(event))
+        {
+        }
+        buffer->mDropped = 0;
+        buffer->mNamed = false;
+    }
+
+    tracer.mFile << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    tracer.mFirstEvent = true;
+    tracer.mEpoch = Now();
+    tracer.mStopping = false;
+    tracer.mFlusher = std::thread(&Tracer::Flush, &tracer);
+    Enabled = true;
+    return true;
+}
+
+/**
+ * Stop tracing, write everything recorded and close the file
+ * @return Number of spans dropped because a buffer was full
+ */
+size_t Tracer::Stop()
+{
+    auto &tracer = Instance();
+    {
+        std::lock_guard<std::mutex> lock(tracer.mMutex);
+        if (!IsEnabled())
+        {
+            return 0;
+        }
+
+        Enabled = false;
+        tracer.mStopping = true;
+    }
+
+    tracer.mWake.notify_all();
+    tracer.mFlusher.join();
+
+    std::lock_guard<std::mutex> lock(tracer.mMutex);
+    tracer.Drain();
+
+    size_t dropped = 0;
+    for (auto &buffer : tracer.mBuffers)
+    {
+        dropped += buffer->mDropped;
+    }
+
+    tracer.mFile << "\n]}\n";
+    tracer.mFile.close();
+    return dropped;
+}
+
+/**
+ * Flusher thread. Drains the buffers until tracing stops.
+ */
+void Tracer::Flush()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (!mStopping)
+    {
+        mWake.wait_for(lock, FlushInterval);
+        Drain();
+    }
+}
+
+/**
+ * Write every span waiting in the buffers. Called with the mutex held.
+ */
+void Tracer::Drain()
+{
+    Event event;
+    for (auto &buffer : mBuffers)
+    {
+        while (buffer->mEvents.Pop(event))
+        {
+            if (!buffer->mNamed)
+            {
+                WriteThreadName(buffer->mThread);
+                buffer->mNamed = true;
+            }
+
+            WriteEvent(event, buffer->mThread);
+        }
+    }
+
+    mFile.flush();
+}
+
+/**
+ * Write a complete event for a span
+ * @param event Span to write
+ * @param thread Id of the thread that recorded it
+ */
+void Tracer::WriteEvent(const Event &event, int thread)
+{
+    std::string name = event.mName;
+    if (event.mType != nullptr)
+    {
+        auto found = mTypeNames.find(*event.mType);
+        if (found == mTypeNames.end())
+        {
+            found = mTypeNames.emplace(*event.mType, ComponentProfiler::TypeName(*event.mType)).first;
+        }
+        name = found->second + "::" + name;
+    }
+
+    mFile << (mFirstEvent ? "\n" : ",\n");
+    mFirstEvent = false;
+    mFile << wxString::Format("{\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, "
+                              "\"pid\": 1, \"tid\": %d}", name.c_str(), event.mCategory,
+                              (event.mStart - mEpoch) / 1000.0, event.mDuration / 1000.0, thread).utf8_string();
+}
+
+/**
+ * Write the metadata event that names a thread
+ * @param thread Id of the thread
+ */
+void Tracer::WriteThreadName(int thread)
+{
+    mFile << (mFirstEvent ? "\n" : ",\n");
+    mFirstEvent = false;
+    mFile << wxString::Format("{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, "
+                              "\"args\": {\"name\": \"thread %d\"}}", thread, thread).utf8_string();
+}
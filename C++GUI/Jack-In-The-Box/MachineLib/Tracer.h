@@ -0,0 +1,183 @@
+/**
+ * @file Tracer.h
+ * @author Jaylon Sifuentes
+ *
+ * Records spans of work to a Chrome trace file.
+ */
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <typeindex>
+#include <vector>
+#include "LockFreeQueue.h"
+
+/**
+ * Process wide recorder of spans of work, written as Chrome trace
+ * event JSON that can be opened in chrome://tracing or Perfetto.
+ *
+ * Each thread records into a lock-free ring buffer of its own, so
+ * recording a span never blocks or allocates. A background thread
+ * drains the buffers and writes the file. If a buffer fills before
+ * it is drained the span is dropped and counted.
+ *
+ * Span names must be string literals, since only the pointer is
+ * recorded. When tracing is not running a span costs one atomic load.
+ */
+class Tracer
+{
+public:
+    /**
+     * A recorded span
+     */
+    struct Event
+    {
+        /// Name of the span
+        const char *mName = nullptr;
+        /// Type the span belongs to, prefixed to the name if not nullptr
+        const std::type_info *mType = nullptr;
+        /// Category of the span
+        const char *mCategory = nullptr;
+        /// Start of the span in steady clock nanoseconds
+        int64_t mStart = 0;
+        /// Duration of the span in nanoseconds
+        int64_t mDuration = 0;
+    };
+
+    /**
+     * Records a span for the lifetime of the object while tracing
+     */
+    class Span
+    {
+    private:
+        /// The span, if tracing. mName is nullptr if not.
+        Event mEvent;
+
+    public:
+        /**
+         * Constructor. Starts the span if tracing.
+         * @param name Name of the span. Must be a string literal.
+         * @param category Category of the span. Must be a string literal.
+         */
+        Span(const char *name, const char *category)
+        {
+            if (IsEnabled())
+            {
+                mEvent.mName = name;
+                mEvent.mCategory = category;
+                mEvent.mStart = Now();
+            }
+        }
+
+        /// delete the copy constructor
+        Span(const Span&) = delete;
+
+        /// delete the copy assignment operator
+        Span& operator=(const Span&) = delete;
+
+        /**
+         * Destructor. Records the span.
+         */
+        ~Span()
+        {
+            if (mEvent.mName != nullptr)
+            {
+                mEvent.mDuration = Now() - mEvent.mStart;
+                Record(mEvent);
+            }
+        }
+    };
+
+    /// Number of spans each thread buffer holds
+    static constexpr size_t BufferSize = 16384;
+
+private:
+    /**
+     * The spans recorded by one thread
+     */
+    struct ThreadBuffer
+    {
+        /// Spans waiting to be written
+        LockFreeQueue<Event, BufferSize> mEvents;
+        /// Thread id written to the trace
+        int mThread = 0;
+        /// True once the thread name has been written
+        bool mNamed = false;
+        /// Spans dropped because the buffer was full
+        std::atomic<size_t> mDropped{0};
+    };
+
+    /// True while tracing
+    static inline std::atomic<bool> Enabled{false};
+
+    /// Protects everything below
+    std::mutex mMutex;
+
+    /// The buffer of every thread that has recorded a span
+    std::vector<std::shared_ptr<ThreadBuffer>> mBuffers;
+
+    /// The trace file
+    std::ofstream mFile;
+
+    /// True until the first event is written
+    bool mFirstEvent = true;
+
+    /// Steady clock nanoseconds at the start of the trace
+    int64_t mEpoch = 0;
+
+    /// Readable names of the types seen so far
+    std::map<std::type_index, std::string> mTypeNames;
+
+    /// Thread that drains the buffers
+    std::thread mFlusher;
+
+    /// Wakes the flusher when tracing stops
+    std::condition_variable mWake;
+
+    /// Set to stop the flusher
+    bool mStopping = false;
+
+    static Tracer &Instance();
+    static ThreadBuffer &Buffer();
+
+    void Flush();
+    void Drain();
+    void WriteEvent(const Event &event, int thread);
+    void WriteThreadName(int thread);
+
+public:
+    /**
+     * Determine if spans are being recorded
+     * @return true while tracing
+     */
+    static bool IsEnabled() { return Enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * Get the current time in the clock spans are recorded in
+     * @return Steady clock nanoseconds
+     */
+    static int64_t Now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static void Record(const Event &event);
+
+    static bool Start(const std::string &filename);
+
+    static size_t Stop();
+};
+
+
+#endif //TRACER_H
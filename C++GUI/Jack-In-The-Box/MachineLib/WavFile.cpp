@@ -0,0 +1,169 @@
+/**
+ * @file WavFile.cpp
+ * @author Jaylon Sifuentes
+ */
+
+#include "pch.h"
+#include <wx/file.h>
+#include "WavFile.h"
+
+/// Size of the header written by Encode in bytes
+const size_t WavHeaderSize = 44;
+
+/**
+ * Read a little endian 16 bit value
+ * @param data Data to read from
+ * @return Value
+ */
+static uint16_t Read16(const uint8_t *data)
+{
+    return data[0] | (data[1] << 8);
+}
+
+/**
+ * Read a little endian 32 bit value
+ * @param data Data to read from
+ * @return Value
+ */
+static uint32_t Read32(const uint8_t *data)
+{
+    return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+/**
+ * Write a little endian 16 bit value
+ * @param data Data to write to
+ * @param value Value to write
+ */
+static void Write16(uint8_t *data, uint16_t value)
+{
+    data[0] = value & 0xff;
+    data[1] = value >> 8;
+}
+
+/**
+ * Write a little endian 32 bit value
+ * @param data Data to write to
+ * @param value Value to write
+ */
+static void Write32(uint8_t *data, uint32_t value)
+{
+    Write16(data, value & 0xffff);
+    Write16(data + 2, value >> 16);
+}
+
+/**
+ * Read and decode a WAV file.
+ *
+ * The file must be 16 bit PCM, mono or stereo, at SampleRate.
+ * Mono files are converted to stereo.
+ *
+ * @param filename File to read
+ * @param samples Receives the interleaved stereo samples
+ * @return true if successful
+ */
+bool WavFile::Read(const std::wstring &filename, std::vector<int16_t> &samples)
+{
+    // Prevent error popup from wxWidgets
+    wxLogNull logNo;
+
+    wxFile file;
+    if (!file.Open(filename))
+    {
+        return false;
+    }
+
+    std::vector<uint8_t> data(file.Length());
+    if (data.size() < 12 || file.Read(data.data(), data.size()) != (ssize_t)data.size() ||
+        memcmp(data.data(), "RIFF", 4) != 0 || memcmp(data.data() + 8, "WAVE", 4) != 0)
+    {
+        return false;
+    }
+
+    int channels = 0;
+    size_t pos = 12;
+    while (pos + 8 <= data.size())
+    {
+        const uint8_t *chunk = data.data() + pos;
+        size_t size = std::min<size_t>(Read32(chunk + 4), data.size() - pos - 8);
+        if (memcmp(chunk, "fmt ", 4) == 0 && size >= 16)
+        {
+            int format = Read16(chunk + 8);
+            channels = Read16(chunk + 10);
+            int rate = Read32(chunk + 12);
+            int bits = Read16(chunk + 22);
+            if (format != 1 || bits != 16 || rate != SampleRate || (channels != 1 && channels != 2))
+            {
+                return false;
+            }
+        }
+        else if (memcmp(chunk, "data", 4) == 0 && channels != 0)
+        {
+            size_t count = size / 2;
+            samples.resize(count * Channels / channels);
+            for (size_t i = 0; i < count; i++)
+            {
+                int16_t sample = (int16_t)Read16(chunk + 8 + i * 2);
+                if (channels == 1)
+                {
+                    samples[i * 2] = sample;
+                    samples[i * 2 + 1] = sample;
+                }
+                else
+                {
+                    samples[i] = sample;
+                }
+            }
+
+            return true;
+        }
+
+        pos += 8 + size + (size & 1);
+    }
+
+    return false;
+}
+
+/**
+ * Create the header of a WAV file
+ * @param dataSize Size of the sample data that follows in bytes
+ * @return Header data
+ */
+std::vector<uint8_t> WavFile::Header(uint32_t dataSize)
+{
+    std::vector<uint8_t> wav(WavHeaderSize);
+    uint8_t *header = wav.data();
+
+    memcpy(header, "RIFF", 4);
+    Write32(header + 4, WavHeaderSize - 8 + dataSize);
+    memcpy(header + 8, "WAVEfmt ", 8);
+    Write32(header + 16, 16);
+    Write16(header + 20, 1);
+    Write16(header + 22, Channels);
+    Write32(header + 24, SampleRate);
+    Write32(header + 28, SampleRate * Channels * 2);
+    Write16(header + 32, Channels * 2);
+    Write16(header + 34, 16);
+    memcpy(header + 36, "data", 4);
+    Write32(header + 40, dataSize);
+
+    return wav;
+}
+
+/**
+ * Encode samples as a complete WAV file image
+ * @param samples Interleaved stereo samples
+ * @return WAV file data
+ */
+std::vector<uint8_t> WavFile::Encode(const std::vector<int16_t> &samples)
+{
+    std::vector<uint8_t> wav = Header(samples.size() * 2);
+    wav.resize(WavHeaderSize + samples.size() * 2);
+
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        Write16(wav.data() + WavHeaderSize + i * 2, (uint16_t)samples[i]);
+    }
+
+    return wav;
+}
@@ -0,0 +1,38 @@
+/**
+ * @file WavFile.h
+ * @author Jaylon Sifuentes
+ *
+ * Reading and writing 16 bit PCM WAV audio.
+ */
+
+#ifndef WAVFILE_H
+#define WAVFILE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Reading and writing 16 bit PCM WAV audio.
+ *
+ * Audio is kept as interleaved 16 bit stereo samples at
+ * a fixed sample rate, the format of the music box sounds.
+ */
+class WavFile
+{
+public:
+    /// Sample rate of all audio in samples per second
+    static const int SampleRate = 44100;
+
+    /// Number of interleaved channels
+    static const int Channels = 2;
+
+    static bool Read(const std::wstring &filename, std::vector<int16_t> &samples);
+
+    static std::vector<uint8_t> Header(uint32_t dataSize);
+
+    static std::vector<uint8_t> Encode(const std::vector<int16_t> &samples);
+};
+
+
+#endif //WAVFILE_H
@@ -0,0 +1,351 @@
+/**
+ * @file XmlStreamReader.cpp
+ * @author Jaylon Sifuentes
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include <cstring>
+#include "XmlStreamReader.h"
+
+/// Size of each read from the file in bytes
+const size_t ChunkSize = 64 * 1024;
+
+/**
+ * Append a character code to a UTF-8 string
+ * @param text String to append to
+ * @param code Unicode character code
+ */
+static void AppendUtf8(std::string &text, unsigned long code)
+{
+    if (code < 0x80)
+    {
+        text += (char)code;
+    }
+    else if (code < 0x800)
+    {
+        text += (char)(0xc0 | (code >> 6));
+        text += (char)(0x80 | (code & 0x3f));
+    }
+    else if (code < 0x10000)
+    {
+        text += (char)(0xe0 | (code >> 12));
+        text += (char)(0x80 | ((code >> 6) & 0x3f));
+        text += (char)(0x80 | (code & 0x3f));
+    }
+    else
+    {
+        text += (char)(0xf0 | (code >> 18));
+        text += (char)(0x80 | ((code >> 12) & 0x3f));
+        text += (char)(0x80 | ((code >> 6) & 0x3f));
+        text += (char)(0x80 | (code & 0x3f));
+    }
+}
+
+/**
+ * Replace the entity references in an attribute value
+ * @param begin Start of the value
+ * @param end End of the value
+ * @param value Receives the decoded value
+ */
+static void Decode(const char *begin, const char *end, std::string &value)
+{
+    value.clear();
+    while (begin < end)
+    {
+        const char *amp = std::find(begin, end, '&');
+        value.append(begin, amp);
+        if (amp == end)
+        {
+            break;
+        }
+
+        const char *semi = std::find(amp, end, ';');
+        std::string entity(amp + 1, semi);
+        if (entity == "lt") value += '<';
+        else if (entity == "gt") value += '>';
+        else if (entity == "amp") value += '&';
+        else if (entity == "quot") value += '"';
+        else if (entity == "apos") value += '\'';
+        else if (entity.size() > 1 && entity[0] == '#')
+        {
+            bool hex = entity[1] == 'x' || entity[1] == 'X';
+            AppendUtf8(value, std::strtoul(entity.c_str() + (hex ? 2 : 1), nullptr, hex ? 16 : 10));
+        }
+        else
+        {
+            value.append(amp, semi);
+        }
+
+        begin = semi < end ? semi + 1 : end;
+    }
+}
+
+/**
+ * Open a file to read
+ * @param filename File to open
+ * @return true if successful
+ */
+bool XmlStreamReader::Open(const std::wstring &filename)
+{
+    // Prevent error popup from wxWidgets
+    wxLogNull logNo;
+
+    mBuffer.resize(ChunkSize);
+    mPos = mEnd = 0;
+    return mFile.Open(filename, "rb");
+}
+
+/**
+ * Read more of the file. Unparsed data is moved to
+ * the start of the buffer, which only grows if a single
+ * tag or comment does not fit in it.
+ * @return false if there is no more data
+ */
+bool XmlStreamReader::Fill()
+{
+    if (!mFile.IsOpened() || mFile.Eof())
+    {
+        return false;
+    }
+
+    if (mPos > 0)
+    {
+        memmove(mBuffer.data(), mBuffer.data() + mPos, mEnd - mPos);
+        mEnd -= mPos;
+        mPos = 0;
+    }
+
+    if (mEnd == mBuffer.size())
+    {
+        mBuffer.resize(mBuffer.size() * 2);
+    }
+
+    size_t read = mFile.Read(mBuffer.data() + mEnd, mBuffer.size() - mEnd);
+    mEnd += read;
+    return read > 0;
+}
+
+/**
+ * Find text in the unparsed data, reading more of the file as needed
+ * @param text Text to find
+ * @param from Offset from mPos to start looking at
+ * @param at Receives the offset of the text from mPos
+ * @return false if the text is not in the rest of the file
+ */
+bool XmlStreamReader::Find(const char *text, size_t from, size_t &at)
+{
+    size_t length = strlen(text);
+    while (true)
+    {
+        const char *begin = mBuffer.data() + mPos;
+        const char *end = mBuffer.data() + mEnd;
+        if (from < mEnd - mPos)
+        {
+            const char *found = std::search(begin + from, end, text, text + length);
+            if (found != end)
+            {
+                at = found - begin;
+                return true;
+            }
+
+            from = std::max(from, mEnd - mPos - std::min(mEnd - mPos, length - 1));
+        }
+
+        if (!Fill())
+        {
+            return false;
+        }
+    }
+}
+
+/**
+ * Find the end of the start tag at mPos. Quoted
+ * attribute values may contain '>'.
+ * @param at Receives the offset of the closing '>' from mPos
+ * @return false if the tag is not closed
+ */
+bool XmlStreamReader::FindTagEnd(size_t &at)
+{
+    char quote = 0;
+    size_t offset = 1;
+    while (true)
+    {
+        for ( ; mPos + offset < mEnd; offset++)
+        {
+            char c = mBuffer[mPos + offset];
+            if (quote != 0)
+            {
+                if (c == quote)
+                {
+                    quote = 0;
+                }
+            }
+            else if (c == '"' || c == '\'')
+            {
+                quote = c;
+            }
+            else if (c == '>')
+            {
+                at = offset;
+                return true;
+            }
+        }
+
+        if (!Fill())
+        {
+            return false;
+        }
+    }
+}
+
+/**
+ * Test if the unparsed data starts with some text
+ * @param text Text to test for
+ * @return true if it does
+ */
+bool XmlStreamReader::StartsWith(const char *text)
+{
+    size_t length = strlen(text);
+    while (mEnd - mPos < length)
+    {
+        if (!Fill())
+        {
+            return false;
+        }
+    }
+
+    return memcmp(mBuffer.data() + mPos, text, length) == 0;
+}
+
+/**
+ * Parse the name and attributes of the start tag at mPos
+ * @param end Offset of the closing '>' from mPos
+ */
+void XmlStreamReader::ParseTag(size_t end)
+{
+    const char *p = mBuffer.data() + mPos + 1;
+    const char *tagEnd = mBuffer.data() + mPos + end;
+    auto isSpace = [](char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; };
+
+    const char *name = p;
+    while (p < tagEnd && !isSpace(*p) && *p != '/')
+    {
+        p++;
+    }
+    mName.assign(name, p);
+
+    size_t count = 0;
+    while (p < tagEnd)
+    {
+        while (p < tagEnd && (isSpace(*p) || *p == '/'))
+        {
+            p++;
+        }
+
+        const char *attribute = p;
+        while (p < tagEnd && !isSpace(*p) && *p != '=')
+        {
+            p++;
+        }
+        const char *attributeEnd = p;
+
+        while (p < tagEnd && *p != '"' && *p != '\'')
+        {
+            p++;
+        }
+        if (p == tagEnd || attribute == attributeEnd)
+        {
+            break;
+        }
+
+        char quote = *p++;
+        const char *value = p;
+        while (p < tagEnd && *p != quote)
+        {
+            p++;
+        }
+
+        // Attribute storage is reused from element to element
+        if (count == mAttributes.size())
+        {
+            mAttributes.emplace_back();
+        }
+        mAttributes[count].first.assign(attribute, attributeEnd);
+        Decode(value, p, mAttributes[count].second);
+        count++;
+        p++;
+    }
+
+    mAttributes.resize(count);
+}
+
+/**
+ * Move to the next element in the file
+ * @return false at the end of the file
+ */
+bool XmlStreamReader::Next()
+{
+    size_t at;
+    while (Find("<", 0, at))
+    {
+        mPos += at;
+
+        size_t end;
+        if (StartsWith("<!--"))
+        {
+            if (!Find("-->", 4, end))
+            {
+                return false;
+            }
+            mPos += end + 3;
+        }
+        else if (StartsWith("<![CDATA["))
+        {
+            if (!Find("]]>", 9, end))
+            {
+                return false;
+            }
+            mPos += end + 3;
+        }
+        else if (StartsWith("<?") || StartsWith("<!") || StartsWith("</"))
+        {
+            if (!Find(">", 2, end))
+            {
+                return false;
+            }
+            mPos += end + 1;
+        }
+        else
+        {
+            if (!FindTagEnd(end))
+            {
+                return false;
+            }
+            ParseTag(end);
+            mPos += end + 1;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Get an attribute of the current element
+ * @param name Attribute name
+ * @return Attribute value or an empty string if there is none
+ */
+const std::string &XmlStreamReader::GetAttribute(const std::string &name) const
+{
+    static const std::string empty;
+    for (auto &attribute : mAttributes)
+    {
+        if (attribute.first == name)
+        {
+            return attribute.second;
+        }
+    }
+
+    return empty;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file XmlStreamReader.h
+ * @author Jaylon Sifuentes
+ *
+ * Forward only reader for the elements of an XML file.
+ */
+
+#ifndef XMLSTREAMREADER_H
+#define XMLSTREAMREADER_H
+
+#include <string>
+#include <utility>
+#include <vector>
+#include <wx/ffile.h>
+
+/**
+ * Forward only reader for the elements of an XML file.
+ *
+ * The file is read in fixed size chunks and each start tag is
+ * parsed in place, so memory use does not grow with the file.
+ * Only element names and attributes are reported. Text, comments,
+ * processing instructions and end tags are skipped.
+ *
+ * Names and values are UTF-8.
+ */
+class XmlStreamReader
+{
+private:
+    /// The file being read
+    wxFFile mFile;
+
+    /// Data read from the file and not yet parsed starts at mPos
+    std::vector<char> mBuffer;
+
+    /// Position of the first unparsed character in mBuffer
+    size_t mPos = 0;
+
+    /// End of the data in mBuffer
+    size_t mEnd = 0;
+
+    /// Name of the current element
+    std::string mName;
+
+    /// Attributes of the current element
+    std::vector<std::pair<std::string, std::string>> mAttributes;
+
+    bool Fill();
+    bool Find(const char *text, size_t from, size_t &at);
+    bool FindTagEnd(size_t &at);
+    bool StartsWith(const char *text);
+    void ParseTag(size_t end);
+
+public:
+    bool Open(const std::wstring &filename);
+
+    bool Next();
+
+    /**
+     * Get the name of the current element
+     * @return Element name
+     */
+    const std::string &GetName() const { return mName; }
+
+    const std::string &GetAttribute(const std::string &name) const;
+};
+
+
+#endif //XMLSTREAMREADER_H
@@ -0,0 +1,171 @@
+/**
+ * @file MachineScalingBenchmark.cpp
+ * @author Jaylon Sifuentes
+ *
+ * Measures how simulating and drawing a machine scales with its size.
+ *
+ * Usage: MachineScalingBenchmark resources-dir [options]
+ *
+ * Options:
+ *   --sizes N,N,...  Component counts to generate (default 100,1000,5000,10000)
+ *   --depth N        Maximum drive tree depth (default 8)
+ *   --seed N         Random seed for the generated machines (default 1)
+ *   --frames N       Frames to simulate at each size (default 300)
+ *   --draws N        Frames to draw at each size (default 10)
+ *
+ * For each size a random machine is generated, and the median time
+ * to build it, advance it one frame and draw it offscreen is reported.
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include "Machine.h"
+#include "MachineGenerator.h"
+
+/// Frame rate the machines are advanced at
+const double FrameRate = 30;
+
+/// Size of the offscreen image drawn into
+const wxSize DrawSize = wxSize(1280, 1024);
+
+/// Location of the machine origin in the offscreen image
+const wxPoint DrawOrigin = wxPoint(640, 900);
+
+/// Clock used for the timings
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Median of a set of times
+ * @param times Times, reordered by this function
+ * @return Median time
+ */
+static double Median(std::vector<double> &times)
+{
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+/**
+ * Milliseconds since a start time
+ * @param start Start time
+ * @return Elapsed time in milliseconds
+ */
+static double ElapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/**
+ * Main entry point
+ * @param argc Argument count
+ * @param argv Arguments
+ * @return Exit code
+ */
+int main(int argc, char **argv)
+{
+    std::vector<int> sizes = {100, 1000, 5000, 10000};
+    int depth = 8;
+    unsigned seed = 1;
+    int frames = 300;
+    int draws = 10;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--sizes" && i + 1 < argc)
+        {
+            sizes.clear();
+            std::stringstream list(argv[++i]);
+            std::string size;
+            while (std::getline(list, size, ','))
+            {
+                sizes.push_back(std::atoi(size.c_str()));
+            }
+        }
+        else if (arg == "--depth" && i + 1 < argc)
+        {
+            depth = std::atoi(argv[++i]);
+        }
+        else if (arg == "--seed" && i + 1 < argc)
+        {
+            seed = (unsigned)std::atol(argv[++i]);
+        }
+        else if (arg == "--frames" && i + 1 < argc)
+        {
+            frames = std::atoi(argv[++i]);
+        }
+        else if (arg == "--draws" && i + 1 < argc)
+        {
+            draws = std::atoi(argv[++i]);
+        }
+        else
+        {
+            positional.push_back(arg);
+        }
+    }
+
+    if (positional.size() != 1 || sizes.empty() || depth < 1 || frames < 1 || draws < 1)
+    {
+        std::cerr << "Usage: MachineScalingBenchmark resources-dir [--sizes N,N,...] [--depth N] [--seed N] "
+                     "[--frames N] [--draws N]" << std::endl;
+        return 1;
+    }
+
+    wxInitializer initializer(argc, argv);
+    if (!initializer.IsOk())
+    {
+        std::cerr << "Unable to initialize wxWidgets" << std::endl;
+        return 1;
+    }
+    wxInitAllImageHandlers();
+
+    MachineGenerator generator(wxString::FromUTF8(positional[0].c_str()).ToStdWstring());
+    generator.SetDepth(depth);
+    generator.SetSeed(seed);
+
+    std::cout << "components    build ms   simulate us/frame   ns/component   draw ms/frame   us/component" << std::endl;
+    for (auto size : sizes)
+    {
+        generator.SetComponentCount(size);
+
+        auto start = Clock::now();
+        auto machine = generator.Create();
+        machine->Compile();
+        double build = ElapsedMs(start);
+
+        std::vector<double> simulate;
+        for (int frame = 0; frame < frames; frame++)
+        {
+            start = Clock::now();
+            machine->Advance(1.0 / FrameRate);
+            simulate.push_back(ElapsedMs(start));
+        }
+
+        wxImage image(DrawSize.GetWidth(), DrawSize.GetHeight());
+        std::vector<double> draw;
+        for (int frame = 0; frame < draws; frame++)
+        {
+            machine->Advance(1.0 / FrameRate);
+
+            // The context is created outside the timing, but its
+            // destruction writes the image and is part of drawing
+            std::shared_ptr<wxGraphicsContext> graphics(wxGraphicsContext::Create(image));
+            start = Clock::now();
+            graphics->Translate(DrawOrigin.x, DrawOrigin.y);
+            machine->Draw(graphics);
+            graphics.reset();
+            draw.push_back(ElapsedMs(start));
+        }
+
+        double simulateMs = Median(simulate);
+        double drawMs = Median(draw);
+        std::cout << wxString::Format("%10d %11.2f %19.2f %14.1f %15.2f %14.2f", size, build, simulateMs * 1000,
+                                      simulateMs * 1e6 / size, drawMs, drawMs * 1000 / size).utf8_string()
+                  << std::endl;
+    }
+
+    return 0;
+}
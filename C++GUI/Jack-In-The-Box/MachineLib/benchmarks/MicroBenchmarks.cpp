@@ -0,0 +1,452 @@
+/**
+ * @file MicroBenchmarks.cpp
+ * @author Jaylon Sifuentes
+ *
+ * Microbenchmarks for the MachineLib hot paths.
+ *
+ * Usage: MicroBenchmarks resources-dir [options]
+ *
+ * Options:
+ *   --iterations N   Timed iterations of each benchmark (default 200)
+ *   --warmup N       Untimed iterations before timing (default 10)
+ *   --filter TEXT    Only run benchmarks whose name contains TEXT
+ *   --json FILE      Also write the results to FILE as JSON
+ *
+ * Every benchmark reports the median, 99th percentile and mean time
+ * per iteration, and the number of heap allocations per iteration,
+ * counted by replacing the global operator new.
+ */
+
+#include "pch.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include "Cylinder.h"
+#include "DisplayList.h"
+#include "Machine.h"
+#include "Machine2Factory.h"
+#include "MachineCFactory.h"
+#include "MachineSystem.h"
+#include "MusicBox.h"
+#include "Polygon.h"
+#include "Song.h"
+#include "Sparty.h"
+
+/// Number of heap allocations made by the program
+static std::atomic<size_t> Allocations{0};
+
+/**
+ * Allocate memory, counting the allocation
+ * @param size Number of bytes
+ * @return Allocated memory
+ */
+void *operator new(size_t size)
+{
+    Allocations.fetch_add(1, std::memory_order_relaxed);
+    void *memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+/**
+ * Allocate an array, counting the allocation
+ * @param size Number of bytes
+ * @return Allocated memory
+ */
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+/**
+ * Free memory allocated by operator new
+ * @param memory Memory to free
+ */
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+/**
+ * Free memory allocated by operator new[]
+ * @param memory Memory to free
+ */
+void operator delete[](void *memory) noexcept
+{
+    std::free(memory);
+}
+
+/**
+ * Free memory allocated by operator new
+ * @param memory Memory to free
+ */
+void operator delete(void *memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+/**
+ * Free memory allocated by operator new[]
+ * @param memory Memory to free
+ */
+void operator delete[](void *memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+/**
+ * Allocate over-aligned memory, counting the allocation
+ * @param size Number of bytes
+ * @param alignment Required alignment
+ * @return Allocated memory
+ */
+void *operator new(size_t size, std::align_val_t alignment)
+{
+    Allocations.fetch_add(1, std::memory_order_relaxed);
+    const size_t align = static_cast<size_t>(alignment);
+#ifdef _WIN32
+    void *memory = _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+    // aligned_alloc needs the size to be a multiple of the alignment
+    void *memory = std::aligned_alloc(align, (std::max(size, (size_t)1) + align - 1) / align * align);
+#endif
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+/**
+ * Allocate an over-aligned array, counting the allocation
+ * @param size Number of bytes
+ * @param alignment Required alignment
+ * @return Allocated memory
+ */
+void *operator new[](size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+/**
+ * Free memory allocated by the aligned operator new
+ * @param memory Memory to free
+ */
+void operator delete(void *memory, std::align_val_t) noexcept
+{
+#ifdef _WIN32
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+
+/**
+ * Free memory allocated by the aligned operator new[]
+ * @param memory Memory to free
+ * @param alignment Alignment it was allocated with
+ */
+void operator delete[](void *memory, std::align_val_t alignment) noexcept
+{
+    operator delete(memory, alignment);
+}
+
+/**
+ * Free memory allocated by the aligned operator new
+ * @param memory Memory to free
+ * @param alignment Alignment it was allocated with
+ */
+void operator delete(void *memory, size_t, std::align_val_t alignment) noexcept
+{
+    operator delete(memory, alignment);
+}
+
+/**
+ * Free memory allocated by the aligned operator new[]
+ * @param memory Memory to free
+ * @param alignment Alignment it was allocated with
+ */
+void operator delete[](void *memory, size_t, std::align_val_t alignment) noexcept
+{
+    operator delete(memory, alignment);
+}
+
+/// Width of the offscreen image drawn into
+const int DrawWidth = 1024;
+
+/// Height of the offscreen image drawn into
+const int DrawHeight = 768;
+
+/// Frame rate the machine systems run at
+const double FrameRate = 30;
+
+/// Frames a long seek may jump
+const int SeekRange = 10000;
+
+/**
+ * Statistics for one benchmark
+ */
+struct Result
+{
+    /// Name of the benchmark
+    std::string mName;
+    /// Timed iterations
+    int mIterations = 0;
+    /// Median time per iteration in microseconds
+    double mMedian = 0;
+    /// 99th percentile time per iteration in microseconds
+    double mP99 = 0;
+    /// Mean time per iteration in microseconds
+    double mMean = 0;
+    /// Heap allocations per iteration
+    double mAllocations = 0;
+};
+
+/**
+ * Runs benchmarks and collects their results
+ */
+class Runner
+{
+private:
+    /// Timed iterations of each benchmark
+    int mIterations = 200;
+    /// Untimed iterations before timing
+    int mWarmup = 10;
+    /// Only benchmarks whose name contains this are run
+    std::string mFilter;
+    /// Results so far
+    std::vector<Result> mResults;
+
+public:
+    /**
+     * Set the number of timed iterations
+     * @param iterations Iterations of each benchmark
+     */
+    void SetIterations(int iterations) { mIterations = iterations; }
+
+    /**
+     * Set the number of untimed iterations before timing
+     * @param warmup Iterations of each benchmark
+     */
+    void SetWarmup(int warmup) { mWarmup = warmup; }
+
+    /**
+     * Only run benchmarks whose name contains some text
+     * @param filter Text to look for
+     */
+    void SetFilter(const std::string &filter) { mFilter = filter; }
+
+    /**
+     * Get the results of the benchmarks run so far
+     * @return Results
+     */
+    const std::vector<Result> &GetResults() const { return mResults; }
+
+    /**
+     * Run a benchmark
+     * @param name Name of the benchmark
+     * @param iteration Function that runs one iteration
+     */
+    template<class Iteration>
+    void Run(const std::string &name, Iteration iteration)
+    {
+        if (name.find(mFilter) == std::string::npos)
+        {
+            return;
+        }
+
+        for (int i = 0; i < mWarmup; i++)
+        {
+            iteration(i);
+        }
+
+        std::vector<double> times;
+        times.reserve(mIterations);
+        size_t allocations = Allocations.load();
+        for (int i = 0; i < mIterations; i++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            iteration(mWarmup + i);
+            auto end = std::chrono::steady_clock::now();
+            times.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+        }
+        // The times vector was reserved, so the loop itself does not allocate
+        allocations = Allocations.load() - allocations;
+
+        Result result;
+        result.mName = name;
+        result.mIterations = mIterations;
+        for (auto time : times)
+        {
+            result.mMean += time / mIterations;
+        }
+        std::sort(times.begin(), times.end());
+        result.mMedian = times[times.size() / 2];
+        result.mP99 = times[std::min(times.size() - 1, times.size() * 99 / 100)];
+        result.mAllocations = (double)allocations / mIterations;
+        mResults.push_back(result);
+
+        std::cout << wxString::Format("%-32s %12.2f %12.2f %12.2f %10.1f", name.c_str(), result.mMedian,
+                                      result.mP99, result.mMean, result.mAllocations).utf8_string() << std::endl;
+    }
+
+    bool WriteJson(const std::string &filename) const;
+};
+
+/**
+ * Write the results to a JSON file
+ * @param filename File to write
+ * @return true if successful
+ */
+bool Runner::WriteJson(const std::string &filename) const
+{
+    std::ofstream file(filename);
+    file << "{\n  \"iterations\": " << mIterations << ",\n  \"warmup\": " << mWarmup << ",\n  \"benchmarks\": [";
+    for (size_t i = 0; i < mResults.size(); i++)
+    {
+        auto &result = mResults[i];
+        file << (i > 0 ? "," : "") << "\n    {\"name\": \"" << result.mName
+             << "\", \"median_us\": " << result.mMedian
+             << ", \"p99_us\": " << result.mP99
+             << ", \"mean_us\": " << result.mMean
+             << ", \"allocations\": " << result.mAllocations << "}";
+    }
+    file << "\n  ]\n}\n";
+    return (bool)file;
+}
+
+/**
+ * Main entry point
+ * @param argc Argument count
+ * @param argv Arguments
+ * @return Exit code
+ */
+int main(int argc, char **argv)
+{
+    Runner runner;
+    std::string json;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--iterations" && i + 1 < argc)
+        {
+            runner.SetIterations(std::max(1, std::atoi(argv[++i])));
+        }
+        else if (arg == "--warmup" && i + 1 < argc)
+        {
+            runner.SetWarmup(std::max(0, std::atoi(argv[++i])));
+        }
+        else if (arg == "--filter" && i + 1 < argc)
+        {
+            runner.SetFilter(argv[++i]);
+        }
+        else if (arg == "--json" && i + 1 < argc)
+        {
+            json = argv[++i];
+        }
+        else
+        {
+            positional.push_back(arg);
+        }
+    }
+
+    if (positional.size() != 1)
+    {
+        std::cerr << "Usage: MicroBenchmarks resources-dir [--iterations N] [--warmup N] [--filter TEXT] [--json FILE]"
+                  << std::endl;
+        return 1;
+    }
+
+    wxInitializer initializer(argc, argv);
+    if (!initializer.IsOk())
+    {
+        std::cerr << "Unable to initialize wxWidgets" << std::endl;
+        return 1;
+    }
+    wxInitAllImageHandlers();
+
+    std::wstring resourcesDir = wxString::FromUTF8(positional[0].c_str()).ToStdWstring();
+    std::wstring imagesDir = resourcesDir + L"/images";
+
+    wxImage image(DrawWidth, DrawHeight);
+    std::shared_ptr<wxGraphicsContext> graphics(wxGraphicsContext::Create(image));
+    graphics->Translate(DrawWidth / 2, DrawHeight - 100);
+
+    std::cout << "benchmark                         median us       p99 us      mean us     allocs" << std::endl;
+
+    MachineSystem system(resourcesDir);
+    system.Mute(true);
+    system.SetFrameRate(FrameRate);
+    system.ChooseMachine(1);
+
+    runner.Run("SetMachineFrame/step", [&](int i) { system.SetMachineFrame(i + 1); });
+
+    system.SetMachineFrame(0);
+    runner.Run("SetMachineFrame/seek", [&](int i) { system.SetMachineFrame((i * 7919) % SeekRange + 1); });
+
+    system.SetMachineFrame(0);
+    runner.Run("MachineSystem::DrawMachine", [&](int i) { system.DrawMachine(graphics); });
+
+    system.SetMachineFrame(0);
+    runner.Run("MachineSystem::DrawMachine/step", [&](int i) {
+        system.SetMachineFrame(i + 1);
+        system.DrawMachine(graphics);
+    });
+
+    MachineCFactory factory1(resourcesDir);
+    runner.Run("MachineCFactory::Create", [&](int i) { factory1.Create(); });
+
+    Machine2Factory factory2(resourcesDir);
+    runner.Run("Machine2Factory::Create", [&](int i) { factory2.Create(); });
+
+    std::wstring song = resourcesDir + L"/songs/fight.xml";
+    MusicBox music(resourcesDir, song);
+    // Prefers the binary song next to the XML when there is one
+    runner.Run("MusicBox::LoadXMLSong/binary", [&](int i) { music.LoadXMLSong(song); });
+
+    Song xmlSong;
+    runner.Run("Song::Load/xml", [&](int i) { xmlSong.Load(song); });
+
+    cse335::Cylinder cylinder;
+    cylinder.SetSize(40, 80);
+    cylinder.SetColour(wxColour(205, 250, 5));
+    cylinder.SetLines(wxColour(139, 168, 7), 4, 6);
+    runner.Run("Cylinder::Draw", [&](int i) { cylinder.Draw(graphics, 0, -200, i * 0.01); });
+
+    cse335::Polygon colored;
+    colored.Rectangle(-50, 0, 100, 100);
+    colored.SetColor(*wxRED);
+    runner.Run("Polygon::DrawPolygon/color", [&](int i) { colored.DrawPolygon(graphics, 0, -200, i * 0.01); });
+
+    cse335::Polygon imaged;
+    imaged.Rectangle(-50, 0, 100, 100);
+    imaged.SetImage(imagesDir + L"/sparty.png");
+    runner.Run("Polygon::DrawPolygon/image", [&](int i) { imaged.DrawPolygon(graphics, 0, -200, i * 0.01); });
+
+    Sparty sparty(imagesDir + L"/sparty.png", 212, 260, 80, 15, false, 0);
+    DisplayList spring;
+    runner.Run("Sparty::DrawSpring", [&](int i) {
+        spring.Begin();
+        sparty.DrawSpring(spring, 0, -50, 80 + i % 100, 80, 15);
+        spring.End();
+        spring.Replay(graphics);
+    });
+
+    graphics.reset();
+
+    if (!json.empty() && !runner.WriteJson(json))
+    {
+        std::cerr << "Unable to write " << json << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
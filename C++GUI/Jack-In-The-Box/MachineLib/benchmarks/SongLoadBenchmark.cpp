@@ -0,0 +1,163 @@
+/**
+ * @file SongLoadBenchmark.cpp
+ * @author Jaylon Sifuentes
+ *
+ * Compares the time to load songs with the DOM, streaming and binary loaders.
+ *
+ * Usage: SongLoadBenchmark resources-dir [options]
+ *
+ * Options:
+ *   --notes N       Notes in the synthetic song (default 20000)
+ *   --runs N        Loads of each song with each loader (default 20)
+ *
+ * Loads fight.xml, pop.xml and a synthetic song written to a
+ * temporary file, and reports the median load time of each loader.
+ * The binary form of each song is written to a temporary file.
+ */
+
+#include "pch.h"
+#include <wx/filename.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include "Song.h"
+
+/// Note names used in the synthetic song
+const char *SyntheticNotes[] = {"g3", "a3", "b3", "c4", "d4", "e4", "f4", "g4"};
+
+/**
+ * Write a synthetic song
+ * @param filename File to write
+ * @param notes Number of notes
+ * @return true if successful
+ */
+static bool WriteSyntheticSong(const wxString &filename, int notes)
+{
+    std::ofstream file(filename.utf8_string());
+    file << "<?xml version='1.0' encoding='UTF-8'?>\n<song beats=\"4\">\n    <sounds>\n";
+    for (auto note : SyntheticNotes)
+    {
+        file << "        <sound note=\"" << note << "\" file=\"" << note << ".wav\" />\n";
+    }
+    file << "    </sounds>\n    <notes>\n";
+    for (int i = 0; i < notes; i++)
+    {
+        file << "        <note measure=\"" << i / 8 + 1 << "\" beat=\"" << 1 + (i % 8) * 0.5
+             << "\" note=\"" << SyntheticNotes[i * 5 % 8] << "\"/>\n";
+    }
+    file << "    </notes>\n</song>\n";
+    return (bool)file;
+}
+
+/**
+ * Median time to load a song
+ * @param load Function that loads the song once
+ * @param runs Number of loads
+ * @return Median time in milliseconds
+ */
+template<class Loader>
+static double MedianLoadTime(Loader load, int runs)
+{
+    std::vector<double> times;
+    for (int i = 0; i < runs; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        load();
+        auto end = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+/**
+ * Main entry point
+ * @param argc Argument count
+ * @param argv Arguments
+ * @return Exit code
+ */
+int main(int argc, char **argv)
+{
+    int notes = 20000;
+    int runs = 20;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--notes" && i + 1 < argc)
+        {
+            notes = std::atoi(argv[++i]);
+        }
+        else if (arg == "--runs" && i + 1 < argc)
+        {
+            runs = std::atoi(argv[++i]);
+        }
+        else
+        {
+            positional.push_back(arg);
+        }
+    }
+
+    if (positional.size() != 1 || notes < 0 || runs < 1)
+    {
+        std::cerr << "Usage: SongLoadBenchmark resources-dir [--notes N] [--runs N]" << std::endl;
+        return 1;
+    }
+
+    wxInitializer initializer(argc, argv);
+    if (!initializer.IsOk())
+    {
+        std::cerr << "Unable to initialize wxWidgets" << std::endl;
+        return 1;
+    }
+
+    wxString resourcesDir = wxString::FromUTF8(positional[0].c_str());
+    wxString synthetic = wxFileName::CreateTempFileName(L"song");
+    if (!WriteSyntheticSong(synthetic, notes))
+    {
+        std::cerr << "Unable to write " << synthetic.utf8_string() << std::endl;
+        return 1;
+    }
+
+    std::vector<std::pair<std::string, wxString>> songs = {
+        {"fight.xml", resourcesDir + L"/songs/fight.xml"},
+        {"pop.xml", resourcesDir + L"/songs/pop.xml"},
+        {"synthetic", synthetic},
+    };
+
+    // All loaders must produce the same notes
+    auto same = [](const Song &a, const Song &b) {
+        return a.GetNoteCount() == b.GetNoteCount() &&
+               std::equal(a.GetNotes(), a.GetNotes() + a.GetNoteCount(), b.GetNotes(),
+                          [](const Song::Note &a, const Song::Note &b) {
+                              return a.mSound == b.mSound && a.mBeat == b.mBeat;
+                          });
+    };
+
+    wxString binary = wxFileName::CreateTempFileName(L"song");
+    std::cout << "song        notes      dom ms   stream ms   binary ms" << std::endl;
+    bool ok = true;
+    for (auto &song : songs)
+    {
+        std::wstring path = song.second.ToStdWstring();
+        Song dom;
+        Song stream;
+        Song mapped;
+        double domTime = MedianLoadTime([&] { dom.LoadDom(path); }, runs);
+        double streamTime = MedianLoadTime([&] { stream.Load(path); }, runs);
+        stream.SaveBinary(binary.ToStdWstring());
+        double binaryTime = MedianLoadTime([&] { mapped.LoadBinary(binary.ToStdWstring()); }, runs);
+
+        bool matches = same(dom, stream) && same(dom, mapped);
+        ok = ok && matches;
+
+        std::cout << wxString::Format("%-10s %6d %11.3f %11.3f %11.3f%s", song.first.c_str(), (int)stream.GetNoteCount(),
+                                      domTime, streamTime, binaryTime, matches ? "" : "   MISMATCH").utf8_string() << std::endl;
+    }
+
+    wxRemoveFile(synthetic);
+    wxRemoveFile(binary);
+    return ok ? 0 : 1;
+}
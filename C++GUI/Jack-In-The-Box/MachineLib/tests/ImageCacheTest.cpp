@@ -0,0 +1,73 @@
+/**
+ * @file ImageCacheTest.cpp
+ * @author Jaylon Sifuentes
+ *
+ * Checks that the image cache releases images nothing uses.
+ *
+ * Usage: ImageCacheTest image.png
+ *
+ * Loads the image, makes a graphics bitmap from it and releases it,
+ * then checks that the cache entry and its bitmaps are gone.
+ */
+
+#include "pch.h"
+#include <iostream>
+#include "ImageCache.h"
+
+using namespace cse335;
+
+/**
+ * Main entry point
+ * @param argc Argument count
+ * @param argv Arguments
+ * @return Exit code
+ */
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: ImageCacheTest image.png" << std::endl;
+        return 1;
+    }
+
+    wxInitializer initializer(argc, argv);
+    if (!initializer.IsOk())
+    {
+        std::cerr << "Unable to initialize wxWidgets" << std::endl;
+        return 1;
+    }
+    wxInitAllImageHandlers();
+
+    std::wstring filename = wxString::FromUTF8(argv[1]).ToStdWstring();
+    {
+        auto image = ImageCache::GetImage(filename);
+        if (image == nullptr)
+        {
+            std::cerr << "Unable to load " << argv[1] << std::endl;
+            return 1;
+        }
+
+        if (ImageCache::GetImage(filename) != image || ImageCache::GetSize() != 1)
+        {
+            std::cerr << "Image was not shared through the cache" << std::endl;
+            return 1;
+        }
+
+        wxImage target(64, 64);
+        std::shared_ptr<wxGraphicsContext> graphics(wxGraphicsContext::Create(target));
+        if (ImageCache::GetBitmap(graphics, filename).IsNull())
+        {
+            std::cerr << "No bitmap for a cached image" << std::endl;
+            return 1;
+        }
+    }
+
+    if (ImageCache::GetSize() != 0)
+    {
+        std::cerr << "Released image is still cached" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Released image was removed from the cache" << std::endl;
+    return 0;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file MusicBoxSeekTest.cpp
+ * @author Jaylon Sifuentes
+ *
+ * Checks that a music box sought back to the start plays
+ * the same notes as a fresh one.
+ *
+ * Usage: MusicBoxSeekTest resources-dir
+ *
+ * The test song has a note on the very first beat. One music box
+ * is stepped forward from the start. The other is played a while,
+ * sought back to time zero the way Machine::Seek does it, then
+ * stepped forward the same way. Both recordings must match and
+ * must not be silent.
+ */
+
+#include "pch.h"
+#include <iostream>
+#include <sstream>
+#include "MusicBox.h"
+#include "AudioRecorder.h"
+
+/// Test song with a note on the first beat, relative to the resources directory
+const std::wstring SeekSong = L"/tests/songs/seek.xml";
+
+/// Rotation of the first step, a quarter of a measure into the song
+const double StepRotation = 0.125;
+
+/// Machine time of the first step in seconds
+const double StepTime = 0.5;
+
+/// Length of the recordings in seconds
+const double RecordingLength = 2;
+
+/**
+ * Step a music box forward once from the start and record what it plays
+ * @param box Music box at the start of the song
+ * @return The recording as a WAV file
+ */
+static std::string RecordStep(MusicBox &box)
+{
+    std::ostringstream stream;
+    AudioRecorder recorder(stream, 0);
+    box.SetRecorder(&recorder);
+
+    box.SetTime(StepTime);
+    box.UpdateRotation(StepRotation);
+
+    box.SetRecorder(nullptr);
+    recorder.Close(RecordingLength);
+    return stream.str();
+}
+
+/**
+ * Determine if a recording has any sound in it
+ * @param wav The recording as a WAV file
+ * @return true if any sample is not zero
+ */
+static bool HasSound(const std::string &wav)
+{
+    // Skip the 44 byte WAV header
+    for (size_t i = 44; i < wav.size(); i++)
+    {
+        if (wav[i] != 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Main entry point
+ * @param argc Argument count
+ * @param argv Arguments
+ * @return Exit code
+ */
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: MusicBoxSeekTest resources-dir" << std::endl;
+        return 1;
+    }
+
+    wxInitializer initializer(argc, argv);
+    if (!initializer.IsOk())
+    {
+        std::cerr << "Unable to initialize wxWidgets" << std::endl;
+        return 1;
+    }
+    wxInitAllImageHandlers();
+
+    std::wstring resourcesDir = wxString::FromUTF8(argv[1]).ToStdWstring();
+
+    MusicBox fresh(resourcesDir, SeekSong);
+    fresh.Mute(true);
+    fresh.Reset();
+    fresh.SetTime(0);
+    auto freshRecording = RecordStep(fresh);
+
+    MusicBox sought(resourcesDir, SeekSong);
+    sought.Mute(true);
+    sought.Reset();
+    sought.SetTime(StepTime * 4);
+    sought.UpdateRotation(StepRotation * 4);
+
+    // Seek back to the start as Machine::Seek does
+    sought.SetSeeking(true);
+    sought.Reset();
+    sought.SetTime(0);
+    sought.UpdateRotation(0);
+    sought.SetSeeking(false);
+    auto soughtRecording = RecordStep(sought);
+
+    if (!HasSound(freshRecording))
+    {
+        std::cerr << "The fresh music box played nothing" << std::endl;
+        return 1;
+    }
+
+    if (soughtRecording != freshRecording)
+    {
+        std::cerr << "The music box sought to the start did not play the first note" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Seeking to the start plays the same notes as a fresh run" << std::endl;
+    return 0;
+}
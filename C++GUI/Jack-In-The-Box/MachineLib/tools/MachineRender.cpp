@@ -0,0 +1,570 @@
+/**
+ * @file MachineRender.cpp
+ * @author Jaylon Sifuentes
+ *
+ * Batch renders machine frames offscreen.
+ *
+ * Usage: MachineRender resources-dir output [options]
+ *
+ * Options:
+ *   --machine N     Machine number to render (default 1)
+ *   --fps F         Frame rate in frames per second (default 30)
+ *   --size WxH      Image size in pixels (default 800x600)
+ *   --frames A-B    Inclusive frame range to render (default 0-299)
+ *   --threads N     Number of render threads (default all cores)
+ *   --raw           Write a raw RGBA stream to output ('-' for stdout)
+ *                   instead of a PNG sequence in the output directory
+ *   --audio FILE    Also write the machine sound over the frame range
+ *                   to a WAV file
+ *   --trace FILE    Write a Chrome trace of the run to FILE
+ *   --compare DIR   Compare each frame against the reference PNG of the
+ *                   same name in DIR instead of writing it. Frames that
+ *                   differ get a diff image in the output directory.
+ *   --tolerance N   Largest color channel difference a pixel may have
+ *                   from the reference (default 2)
+ *
+ * The frame range is split into chunks that are rendered in parallel.
+ * Each render thread has its own machine system, seeks it to the start
+ * of each chunk it takes and renders the chunk. The output is written
+ * in frame order as the chunks complete.
+ *
+ * The sound is recorded on a thread of its own with another machine
+ * system that steps through the frame range without drawing.
+ *
+ * wxWidgets reference counts are not thread safe, so the render threads
+ * share no wxWidgets objects while they draw. Each thread has its own
+ * machine system, images and graphics context, the components keep
+ * private copies of any stock colors, and the image cache keeps the
+ * graphics bitmaps per thread. Drawing then runs in parallel. Building
+ * and destroying machine systems, which loads and releases shared
+ * images, and encoding the output are serialized with WxMutex.
+ *
+ * Reference images for --compare are made by rendering the same
+ * machine and frames as a PNG sequence into the reference directory.
+ * The exit code is nonzero if any frame differs from its reference.
+ * The golden image tests run by ctest use this against the references
+ * in resources/tests/golden, which the update-golden target renders.
+ */
+
+#include "pch.h"
+#include <wx/filename.h>
+#include <wx/filefn.h>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "MachineSystem.h"
+#include "FrameRenderer.h"
+#include "AudioRecorder.h"
+#include "Tracer.h"
+
+/// Held while building or destroying machine systems and encoding
+/// images. See the file comment.
+static std::mutex WxMutex;
+
+/**
+ * Options for a render run
+ */
+struct RenderOptions
+{
+    /// Resources directory
+    std::wstring mResourcesDir;
+    /// PNG output directory or raw output file
+    std::wstring mOutput;
+    /// Machine number
+    int mMachine = 1;
+    /// Frame rate in frames per second
+    double mFrameRate = 30;
+    /// Image width in pixels
+    int mWidth = 800;
+    /// Image height in pixels
+    int mHeight = 600;
+    /// First frame to render
+    int mFirstFrame = 0;
+    /// Last frame to render
+    int mLastFrame = 299;
+    /// Number of render threads
+    int mThreads = std::max(1u, std::thread::hardware_concurrency());
+    /// Write a raw RGBA stream instead of PNG files
+    bool mRaw = false;
+    /// WAV file to record the sound to, if any
+    std::wstring mAudio;
+    /// Chrome trace file to write, if any
+    std::string mTrace;
+    /// Directory of reference images to compare against, if any
+    std::wstring mCompare;
+    /// Largest color channel difference from the reference
+    int mTolerance = 2;
+};
+
+/**
+ * A range of frames rendered by one render thread
+ */
+struct RenderChunk
+{
+    /// First frame in the chunk
+    int mFirstFrame;
+    /// Last frame in the chunk
+    int mLastFrame;
+    /// Rendered images, in frame order
+    std::vector<wxImage> mImages;
+    /// Set when the images have been rendered
+    bool mDone = false;
+};
+
+/**
+ * Chunks of a render run shared between the render threads and the writer
+ */
+class RenderQueue
+{
+private:
+    /// The chunks in frame order
+    std::vector<RenderChunk> mChunks;
+    /// Next chunk to hand to a render thread
+    size_t mNext = 0;
+    /// Number of chunks that have been written
+    size_t mWritten = 0;
+    /// Chunks allowed to be rendered ahead of the writer
+    size_t mWindow;
+    /// Set when writing failed and no more chunks are to be rendered
+    bool mCancelled = false;
+    /// Protects the queue
+    std::mutex mMutex;
+    /// Signalled when a chunk is rendered or written
+    std::condition_variable mChanged;
+
+public:
+    /**
+     * Constructor
+     * @param first First frame to render
+     * @param last Last frame to render
+     * @param threads Number of render threads
+     */
+    RenderQueue(int first, int last, int threads) : mWindow(threads * 2)
+    {
+        // A few chunks per thread keeps the threads busy to the end
+        int count = last - first + 1;
+        int size = std::max(1, count / (threads * 4));
+        for (int frame = first; frame <= last; frame += size)
+        {
+            mChunks.push_back({frame, std::min(last, frame + size - 1)});
+        }
+    }
+
+    /**
+     * Take the next chunk to render. Waits while too many
+     * chunks are waiting to be written.
+     * @return Chunk to render or nullptr if there are none left
+     * or the run has been cancelled
+     */
+    RenderChunk *Take()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mChanged.wait(lock, [this] {
+            return mCancelled || mNext >= mChunks.size() || mNext < mWritten + mWindow;
+        });
+        return !mCancelled && mNext < mChunks.size() ? &mChunks[mNext++] : nullptr;
+    }
+
+    /**
+     * Mark a chunk as rendered
+     * @param chunk Chunk that has been rendered
+     */
+    void Done(RenderChunk *chunk)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        chunk->mDone = true;
+        mChanged.notify_all();
+    }
+
+    /**
+     * Write every chunk in frame order as it completes
+     * @param write Function that writes one frame image
+     * @return false if writing failed
+     */
+    template<class Writer>
+    bool WriteInOrder(Writer write)
+    {
+        for (auto &chunk : mChunks)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mChanged.wait(lock, [&chunk] { return chunk.mDone; });
+            }
+
+            int frame = chunk.mFirstFrame;
+            for (auto &image : chunk.mImages)
+            {
+                if (!write(frame++, image))
+                {
+                    return false;
+                }
+            }
+
+            chunk.mImages.clear();
+
+            std::lock_guard<std::mutex> lock(mMutex);
+            mWritten++;
+            mChanged.notify_all();
+        }
+
+        return true;
+    }
+
+    /**
+     * Stop handing out chunks. Used when writing fails.
+     */
+    void Cancel()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mCancelled = true;
+        mChanged.notify_all();
+    }
+};
+
+/**
+ * Render thread. Builds a machine system of its own and
+ * renders chunks until there are none left.
+ * @param options Render options
+ * @param queue Queue to take chunks from
+ */
+static void RenderThread(const RenderOptions &options, RenderQueue &queue)
+{
+    std::unique_ptr<MachineSystem> system;
+    {
+        std::lock_guard<std::mutex> lock(WxMutex);
+        system = std::make_unique<MachineSystem>(options.mResourcesDir);
+        system->ChooseMachine(options.mMachine);
+        system->SetFrameRate(options.mFrameRate);
+        system->Mute(true);
+        // The machine is drawn up from its location, so put it at the bottom center
+        system->SetLocation(wxPoint(options.mWidth / 2, options.mHeight * 9 / 10));
+    }
+
+    FrameRenderer renderer(options.mWidth, options.mHeight);
+
+    while (auto chunk = queue.Take())
+    {
+        // The first frame of a chunk is a seek, the rest are single steps
+        for (int frame = chunk->mFirstFrame; frame <= chunk->mLastFrame; frame++)
+        {
+            system->SetMachineFrame(frame);
+            chunk->mImages.push_back(renderer.Draw(*system));
+        }
+
+        queue.Done(chunk);
+    }
+
+    std::lock_guard<std::mutex> lock(WxMutex);
+    system.reset();
+}
+
+/**
+ * Record the machine sound over the frame range.
+ *
+ * The machine is muted, which only stops live playback, and
+ * stepped one frame at a time so every note is recorded at
+ * the time it is struck.
+ *
+ * @param options Render options
+ * @param recorded Set to true if the sound was written
+ */
+static void AudioThread(const RenderOptions &options, bool &recorded)
+{
+    std::ofstream file(wxString(options.mAudio).utf8_string(), std::ios::binary);
+    if (!file)
+    {
+        recorded = false;
+        return;
+    }
+
+    std::unique_ptr<MachineSystem> system;
+    {
+        std::lock_guard<std::mutex> lock(WxMutex);
+        system = std::make_unique<MachineSystem>(options.mResourcesDir);
+        system->ChooseMachine(options.mMachine);
+        system->SetFrameRate(options.mFrameRate);
+        system->Mute(true);
+    }
+
+    AudioRecorder recorder(file, options.mFirstFrame / options.mFrameRate);
+    system->SetRecorder(&recorder);
+
+    for (int frame = options.mFirstFrame; frame <= options.mLastFrame; frame++)
+    {
+        system->SetMachineFrame(frame);
+        recorder.Flush(frame / options.mFrameRate);
+    }
+
+    // The recording lasts as long as the frames are shown
+    recorder.Close((options.mLastFrame + 1) / options.mFrameRate);
+    system->SetRecorder(nullptr);
+    recorded = (bool)file;
+
+    std::lock_guard<std::mutex> lock(WxMutex);
+    system.reset();
+}
+
+/**
+ * Compare a rendered frame against its reference image,
+ * writing a diff image to the output directory if they differ
+ * @param options Render options
+ * @param frame Frame number
+ * @param image Rendered frame
+ * @return true if the frame matches the reference
+ */
+static bool CompareFrame(const RenderOptions &options, int frame, const wxImage &image)
+{
+    wxString name = wxString::Format(L"frame-%05d.png", frame);
+    wxFileName referenceName(options.mCompare, name);
+    wxImage reference;
+    if (!wxFileExists(referenceName.GetFullPath()) || !reference.LoadFile(referenceName.GetFullPath(), wxBITMAP_TYPE_PNG))
+    {
+        std::cerr << "frame " << frame << ": no reference " << referenceName.GetFullPath().utf8_string() << std::endl;
+        return false;
+    }
+
+    if (reference.GetWidth() != image.GetWidth() || reference.GetHeight() != image.GetHeight())
+    {
+        std::cerr << "frame " << frame << ": reference is " << reference.GetWidth() << "x" << reference.GetHeight()
+                  << ", rendered " << image.GetWidth() << "x" << image.GetHeight() << std::endl;
+        return false;
+    }
+
+    wxImage diff;
+    int differing = FrameRenderer::Compare(image, reference, options.mTolerance, diff);
+    if (differing == 0)
+    {
+        return true;
+    }
+
+    wxFileName diffName(options.mOutput, wxString::Format(L"diff-%05d.png", frame));
+    diff.SaveFile(diffName.GetFullPath(), wxBITMAP_TYPE_PNG);
+    std::cerr << "frame " << frame << ": " << differing << " pixels differ, see "
+              << diffName.GetFullPath().utf8_string() << std::endl;
+    return false;
+}
+
+/**
+ * Parse the command line
+ * @param argc Argument count
+ * @param argv Arguments
+ * @param options Options to fill in
+ * @return true if the command line is valid
+ */
+static bool ParseOptions(int argc, char **argv, RenderOptions &options)
+{
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--machine" && hasValue)
+        {
+            options.mMachine = std::atoi(argv[++i]);
+        }
+        else if (arg == "--fps" && hasValue)
+        {
+            options.mFrameRate = std::atof(argv[++i]);
+        }
+        else if (arg == "--size" && hasValue)
+        {
+            if (sscanf(argv[++i], "%dx%d", &options.mWidth, &options.mHeight) != 2)
+            {
+                return false;
+            }
+        }
+        else if (arg == "--frames" && hasValue)
+        {
+            if (sscanf(argv[++i], "%d-%d", &options.mFirstFrame, &options.mLastFrame) != 2)
+            {
+                return false;
+            }
+        }
+        else if (arg == "--threads" && hasValue)
+        {
+            options.mThreads = std::atoi(argv[++i]);
+        }
+        else if (arg == "--raw")
+        {
+            options.mRaw = true;
+        }
+        else if (arg == "--audio" && hasValue)
+        {
+            options.mAudio = wxString::FromUTF8(argv[++i]).ToStdWstring();
+        }
+        else if (arg == "--trace" && hasValue)
+        {
+            options.mTrace = argv[++i];
+        }
+        else if (arg == "--compare" && hasValue)
+        {
+            options.mCompare = wxString::FromUTF8(argv[++i]).ToStdWstring();
+        }
+        else if (arg == "--tolerance" && hasValue)
+        {
+            options.mTolerance = std::atoi(argv[++i]);
+        }
+        else if (arg.rfind("--", 0) == 0)
+        {
+            return false;
+        }
+        else
+        {
+            positional.push_back(arg);
+        }
+    }
+
+    if (positional.size() != 2)
+    {
+        return false;
+    }
+
+    options.mResourcesDir = wxString::FromUTF8(positional[0].c_str()).ToStdWstring();
+    options.mOutput = wxString::FromUTF8(positional[1].c_str()).ToStdWstring();
+
+    return options.mFrameRate > 0 && options.mWidth > 0 && options.mHeight > 0 && options.mThreads > 0 &&
+           options.mFirstFrame >= 0 && options.mLastFrame >= options.mFirstFrame &&
+           options.mTolerance >= 0 && (options.mCompare.empty() || !options.mRaw);
+}
+
+/**
+ * Main entry point
+ * @param argc Argument count
+ * @param argv Arguments
+ * @return Exit code
+ */
+int main(int argc, char **argv)
+{
+    RenderOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        std::cerr << "Usage: MachineRender resources-dir output [--machine N] [--fps F] "
+                     "[--size WxH] [--frames A-B] [--threads N] [--raw] [--audio FILE] [--trace FILE] "
+                     "[--compare DIR] [--tolerance N]" << std::endl;
+        return 1;
+    }
+
+    wxInitializer initializer(argc, argv);
+    if (!initializer.IsOk())
+    {
+        std::cerr << "Unable to initialize wxWidgets" << std::endl;
+        return 1;
+    }
+    wxInitAllImageHandlers();
+
+    // Create the graphics renderer before the render threads use it
+    wxGraphicsRenderer::GetDefaultRenderer();
+
+    std::ofstream file;
+    std::ostream *raw = &std::cout;
+    if (options.mRaw && options.mOutput != L"-")
+    {
+        file.open(wxString(options.mOutput).utf8_string(), std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "Unable to write " << wxString(options.mOutput).utf8_string() << std::endl;
+            return 1;
+        }
+        raw = &file;
+    }
+    else if (!options.mRaw)
+    {
+        wxFileName::Mkdir(options.mOutput, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+    }
+
+    if (!options.mTrace.empty() && !Tracer::Start(options.mTrace))
+    {
+        std::cerr << "Unable to write " << options.mTrace << std::endl;
+        return 1;
+    }
+
+    bool recorded = true;
+    std::thread audio;
+    if (!options.mAudio.empty())
+    {
+        audio = std::thread(AudioThread, std::cref(options), std::ref(recorded));
+    }
+
+    RenderQueue queue(options.mFirstFrame, options.mLastFrame, options.mThreads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < options.mThreads; i++)
+    {
+        threads.emplace_back(RenderThread, std::cref(options), std::ref(queue));
+    }
+
+    int mismatches = 0;
+    bool written = queue.WriteInOrder([&options, raw, &mismatches](int frame, const wxImage &image) {
+        std::lock_guard<std::mutex> lock(WxMutex);
+        if (options.mRaw)
+        {
+            FrameRenderer::WriteRGBA(image, *raw);
+            if (!*raw)
+            {
+                std::cerr << "Unable to write frame " << frame << std::endl;
+                return false;
+            }
+            return true;
+        }
+
+        if (!options.mCompare.empty())
+        {
+            if (!CompareFrame(options, frame, image))
+            {
+                mismatches++;
+            }
+            return true;
+        }
+
+        wxFileName filename(options.mOutput, wxString::Format(L"frame-%05d.png", frame));
+        if (!image.SaveFile(filename.GetFullPath(), wxBITMAP_TYPE_PNG))
+        {
+            std::cerr << "Unable to write " << filename.GetFullPath().utf8_string() << std::endl;
+            return false;
+        }
+        return true;
+    });
+
+    if (!written)
+    {
+        queue.Cancel();
+    }
+    else if (options.mRaw && !raw->flush())
+    {
+        std::cerr << "Unable to write " << wxString(options.mOutput).utf8_string() << std::endl;
+        written = false;
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    if (audio.joinable())
+    {
+        audio.join();
+        if (!recorded)
+        {
+            std::cerr << "Unable to write " << wxString(options.mAudio).utf8_string() << std::endl;
+        }
+    }
+
+    if (!options.mTrace.empty())
+    {
+        size_t dropped = Tracer::Stop();
+        if (dropped > 0)
+        {
+            std::cerr << "Trace dropped " << dropped << " spans" << std::endl;
+        }
+    }
+
+    if (!options.mCompare.empty())
+    {
+        std::cout << mismatches << " of " << options.mLastFrame - options.mFirstFrame + 1
+                  << " frames differ from the reference" << std::endl;
+    }
+
+    return written && recorded && mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file SongConverter.cpp
+ * @author Jaylon Sifuentes
+ *
+ * Converts XML songs to binary song files.
+ *
+ * Usage: SongConverter song.xml [song.xml ...]
+ *
+ * Each song is written next to its XML file with the .song
+ * extension, where the music box loads it in place of the XML.
+ */
+
+#include "pch.h"
+#include <iostream>
+#include "Song.h"
+
+/**
+ * Main entry point
+ * @param argc Argument count
+ * @param argv Arguments
+ * @return Exit code
+ */
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: SongConverter song.xml [song.xml ...]" << std::endl;
+        return 1;
+    }
+
+    wxInitializer initializer(argc, argv);
+    if (!initializer.IsOk())
+    {
+        std::cerr << "Unable to initialize wxWidgets" << std::endl;
+        return 1;
+    }
+
+    int result = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        std::wstring xmlPath = wxString::FromUTF8(argv[i]).ToStdWstring();
+        std::wstring binaryPath = Song::BinaryPath(xmlPath);
+
+        Song song;
+        if (!song.Load(xmlPath))
+        {
+            std::cerr << "Unable to read " << argv[i] << std::endl;
+            result = 1;
+        }
+        else if (!song.SaveBinary(binaryPath))
+        {
+            std::cerr << "Unable to write " << wxString(binaryPath).utf8_string() << std::endl;
+            result = 1;
+        }
+        else
+        {
+            std::cout << argv[i] << ": " << song.GetNoteCount() << " notes, "
+                      << song.GetSoundFiles().size() << " sounds" << std::endl;
+        }
+    }
+
+    return result;
+}